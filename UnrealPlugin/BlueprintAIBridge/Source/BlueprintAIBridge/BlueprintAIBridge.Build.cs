@@ -19,12 +19,16 @@ public class BlueprintAIBridge : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
 			"UnrealEd",
+			"AssetRegistry",
 			"BlueprintGraph",
 			"KismetCompiler",
 			"Kismet",
 			"EditorFramework",
 			"Slate",
-			"SlateCore"
+			"SlateCore",
+			"WebSocketNetworking",
+			"HTTP",
+			"WebSockets"
 		});
 	}
 }
@@ -1,4 +1,6 @@
 #include "BlueprintAIBridgeModule.h"
+#include "BlueprintFunctionIndex.h"
+#include "BridgeWebSocketServer.h"
 #include "HttpServerHandler.h"
 #include "HttpServerModule.h"
 #include "IHttpRouter.h"
@@ -7,6 +9,7 @@
 #define LOCTEXT_NAMESPACE "FBlueprintAIBridgeModule"
 
 static TSharedPtr<FHttpServerHandler> GHandler;
+static TSharedPtr<FBridgeWebSocketServer> GWebSocketServer;
 
 void FBlueprintAIBridgeModule::StartupModule()
 {
@@ -22,17 +25,28 @@ void FBlueprintAIBridgeModule::StartupModule()
 		return;
 	}
 
+	// Build the UFunction lookup index in the background so the first apply doesn't pay for a reflection scan
+	FBlueprintFunctionIndex::Get().Startup();
+
 	GHandler = MakeShared<FHttpServerHandler>();
 	RegisterRoutes();
 	HttpServerModule.StartAllListeners();
 
 	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: HTTP server started on port %d"), ListenPort);
+
+	GWebSocketServer = MakeShared<FBridgeWebSocketServer>(*GHandler);
+	if (!GWebSocketServer->Start(WebSocketPort))
+	{
+		GWebSocketServer.Reset();
+	}
 }
 
 void FBlueprintAIBridgeModule::ShutdownModule()
 {
 	UnregisterRoutes();
+	GWebSocketServer.Reset();
 	GHandler.Reset();
+	FBlueprintFunctionIndex::Get().Shutdown();
 
 	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: HTTP server shut down"));
 }
@@ -64,6 +78,16 @@ void FBlueprintAIBridgeModule::RegisterRoutes()
 		})
 	));
 
+	// POST /api/blueprints/batch-get
+	RouteHandles.Add(HttpRouter->BindRoute(
+		FHttpPath(TEXT("/api/blueprints/batch-get")),
+		EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return GHandler->HandleBatchGetBlueprints(Request, OnComplete);
+		})
+	));
+
 	// GET /api/blueprint
 	RouteHandles.Add(HttpRouter->BindRoute(
 		FHttpPath(TEXT("/api/blueprint")),
@@ -84,6 +108,46 @@ void FBlueprintAIBridgeModule::RegisterRoutes()
 		})
 	));
 
+	// GET /api/blueprint/apply/progress
+	RouteHandles.Add(HttpRouter->BindRoute(
+		FHttpPath(TEXT("/api/blueprint/apply/progress")),
+		EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return GHandler->HandleApplyProgress(Request, OnComplete);
+		})
+	));
+
+	// GET /api/jobs/:id
+	RouteHandles.Add(HttpRouter->BindRoute(
+		FHttpPath(TEXT("/api/jobs/:id")),
+		EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return GHandler->HandleGetJob(Request, OnComplete);
+		})
+	));
+
+	// DELETE /api/jobs/:id
+	RouteHandles.Add(HttpRouter->BindRoute(
+		FHttpPath(TEXT("/api/jobs/:id")),
+		EHttpServerRequestVerbs::VERB_DELETE,
+		FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return GHandler->HandleCancelJob(Request, OnComplete);
+		})
+	));
+
+	// POST /api/blueprint/compile
+	RouteHandles.Add(HttpRouter->BindRoute(
+		FHttpPath(TEXT("/api/blueprint/compile")),
+		EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return GHandler->HandleCompileBlueprint(Request, OnComplete);
+		})
+	));
+
 	// POST /api/blueprint/create
 	RouteHandles.Add(HttpRouter->BindRoute(
 		FHttpPath(TEXT("/api/blueprint/create")),
@@ -93,6 +157,16 @@ void FBlueprintAIBridgeModule::RegisterRoutes()
 			return GHandler->HandleCreateBlueprint(Request, OnComplete);
 		})
 	));
+
+	// GET /api/blueprint/events
+	RouteHandles.Add(HttpRouter->BindRoute(
+		FHttpPath(TEXT("/api/blueprint/events")),
+		EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return GHandler->HandleBlueprintEvents(Request, OnComplete);
+		})
+	));
 }
 
 void FBlueprintAIBridgeModule::UnregisterRoutes()
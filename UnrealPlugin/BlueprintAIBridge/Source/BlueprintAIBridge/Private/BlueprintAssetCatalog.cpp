@@ -0,0 +1,161 @@
+#include "BlueprintAssetCatalog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+
+/** A package's file time, and the saved hash the registry reported when it was read */
+struct FCachedPackageTime
+{
+	FIoHash SavedHash;
+	FDateTime Modified;
+};
+
+/** Catalog queries run on the game thread, so this needs no lock */
+static TMap<FName, FCachedPackageTime> GPackageTimes;
+
+FBlueprintCatalogPage FBlueprintAssetCatalog::Query(const FBlueprintCatalogQuery& Query)
+{
+	const double QueryStart = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FBlueprintCatalogPage Page;
+	Page.bComplete = !AssetRegistry.IsLoadingAssets();
+
+	// Registry-side filtering only reads its in-memory tables; nothing here touches a package.
+	// The folder holding the prefix narrows the search, so engine and plugin blueprints are never gathered for a /Game query.
+	FString SearchFolder = Query.PathPrefix.IsEmpty() ? FString(TEXT("/Game")) : FPackageName::GetLongPackagePath(Query.PathPrefix);
+	if (SearchFolder.IsEmpty())
+	{
+		SearchFolder = Query.PathPrefix;
+	}
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.PackagePaths.Add(FName(*SearchFolder));
+	Filter.bRecursivePaths = true;
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	// Path is a string prefix, not a folder, so "/Game/AI" also matches "/Game/AIDirector"
+	FString PackageName;
+	Assets.RemoveAll([&Query, &PackageName, &AssetRegistry](const FAssetData& AssetData)
+	{
+		if (!Query.PathPrefix.IsEmpty())
+		{
+			AssetData.PackageName.ToString(PackageName);
+			if (!PackageName.StartsWith(Query.PathPrefix))
+			{
+				return true;
+			}
+		}
+		if (!Query.ParentClass.IsEmpty() && !MatchesParentClass(AssetData, Query.ParentClass))
+		{
+			return true;
+		}
+		// Runs after the cheap filters, since a package not seen at its current saved version costs a stat
+		return Query.ModifiedSince.IsSet() && GetModifiedTime(AssetRegistry, AssetData) <= Query.ModifiedSince.GetValue();
+	});
+
+	// FName comparison is lexical and case-insensitive, like the paths themselves
+	auto PathLess = [](const FAssetData& A, const FAssetData& B)
+	{
+		const int32 PackageOrder = A.PackageName.Compare(B.PackageName);
+		return PackageOrder != 0 ? PackageOrder < 0 : A.AssetName.Compare(B.AssetName) < 0;
+	};
+	Assets.Sort(PathLess);
+	Page.Total = Assets.Num();
+
+	int32 First = 0;
+	if (!Query.Cursor.IsEmpty())
+	{
+		const FSoftObjectPath CursorPath(Query.Cursor);
+		FAssetData CursorAsset;
+		CursorAsset.PackageName = CursorPath.GetLongPackageFName();
+		CursorAsset.AssetName = FName(*CursorPath.GetAssetName());
+		First = Algo::UpperBound(Assets, CursorAsset, PathLess);
+	}
+
+	const int32 Limit = FMath::Clamp(Query.Limit, 1, MaxLimit);
+	const int32 Last = FMath::Min(First + Limit, Assets.Num());
+	Page.Entries.SetNum(FMath::Max(Last - First, 0));
+	for (int32 Index = First; Index < Last; Index++)
+	{
+		FillEntry(AssetRegistry, Assets[Index], Page.Entries[Index - First]);
+	}
+	if (Last < Assets.Num() && Page.Entries.Num() > 0)
+	{
+		Page.NextCursor = Page.Entries.Last().Path;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Catalog query matched %d blueprint assets, returned %d, in %.2f ms"),
+		Page.Total, Page.Entries.Num(), (FPlatformTime::Seconds() - QueryStart) * 1000.0);
+	return Page;
+}
+
+bool FBlueprintAssetCatalog::MatchesParentClass(const FAssetData& AssetData, const FString& ParentClass)
+{
+	const FString ParentPath = GetClassTag(AssetData, FBlueprintTags::ParentClassPath);
+	if (ParentPath.IsEmpty())
+	{
+		return false;
+	}
+	if (ParentClass.StartsWith(TEXT("/")))
+	{
+		return ParentPath.Equals(ParentClass, ESearchCase::IgnoreCase);
+	}
+
+	// Short names match with or without the generated-class suffix: "BP_Enemy" and "BP_Enemy_C" are the same parent
+	const FString ShortName = FPackageName::ObjectPathToObjectName(ParentPath);
+	return ShortName.Equals(ParentClass, ESearchCase::IgnoreCase)
+		|| (ShortName.EndsWith(TEXT("_C")) && ShortName.LeftChop(2).Equals(ParentClass, ESearchCase::IgnoreCase));
+}
+
+FString FBlueprintAssetCatalog::GetClassTag(const FAssetData& AssetData, FName Tag)
+{
+	// Class tags are stored as export text ("/Script/CoreUObject.Class'/Script/Engine.Actor'")
+	FString Value;
+	if (!AssetData.GetTagValue(Tag, Value))
+	{
+		return FString();
+	}
+	return FPackageName::ExportTextPathToObjectPath(Value);
+}
+
+FDateTime FBlueprintAssetCatalog::GetModifiedTime(const IAssetRegistry& AssetRegistry, const FAssetData& AssetData)
+{
+	// The registry rescans a package when it is saved, so an unchanged saved hash means the file time is unchanged too
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName);
+	const FIoHash SavedHash = PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash();
+	if (const FCachedPackageTime* Cached = GPackageTimes.Find(AssetData.PackageName))
+	{
+		if (PackageData.IsSet() && Cached->SavedHash == SavedHash)
+		{
+			return Cached->Modified;
+		}
+	}
+
+	FString Filename;
+	if (!FPackageName::TryConvertLongPackageNameToFilename(AssetData.PackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+	{
+		return FDateTime::MinValue();
+	}
+	const FDateTime Modified = IFileManager::Get().GetTimeStamp(*Filename);
+	GPackageTimes.Add(AssetData.PackageName, FCachedPackageTime{ SavedHash, Modified });
+	return Modified;
+}
+
+void FBlueprintAssetCatalog::FillEntry(const IAssetRegistry& AssetRegistry, const FAssetData& AssetData, FBlueprintCatalogEntry& OutEntry)
+{
+	OutEntry.Name = AssetData.AssetName.ToString();
+	OutEntry.Path = AssetData.GetObjectPathString();
+	OutEntry.ParentClass = GetClassTag(AssetData, FBlueprintTags::ParentClassPath);
+	OutEntry.NativeParentClass = GetClassTag(AssetData, FBlueprintTags::NativeParentClassPath);
+	AssetData.GetTagValue(FBlueprintTags::BlueprintType, OutEntry.BlueprintType);
+	AssetData.GetTagValue(FBlueprintTags::NumReplicatedProperties, OutEntry.NumReplicatedProperties);
+	AssetData.GetTagValue(FBlueprintTags::IsDataOnly, OutEntry.bIsDataOnly);
+	OutEntry.bIsLoaded = AssetData.IsAssetLoaded();
+	OutEntry.Modified = GetModifiedTime(AssetRegistry, AssetData);
+}
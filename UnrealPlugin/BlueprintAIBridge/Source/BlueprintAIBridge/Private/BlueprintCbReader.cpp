@@ -0,0 +1,193 @@
+#include "BlueprintCbReader.h"
+#include "Serialization/CompactBinaryValidation.h"
+#include "Memory/MemoryView.h"
+
+FBlueprintCbReader::FBlueprintCbReader(TConstArrayView<uint8> InBody)
+	: Body(InBody)
+{
+}
+
+bool FBlueprintCbReader::ReadDelta(FBlueprintDeltaData& OutDelta)
+{
+	// Field accessors trust their input, so reject truncated or malformed bodies up front
+	const ECbValidateError Validation = ValidateCompactBinary(MakeMemoryView(Body.GetData(), Body.Num()), ECbValidateMode::Default);
+	if (Validation != ECbValidateError::None)
+	{
+		return Fail(TEXT("Malformed Compact Binary body"));
+	}
+
+	FCbFieldView Root(Body.GetData());
+	if (!Root.IsObject())
+	{
+		return Fail(TEXT("Expected a Compact Binary object"));
+	}
+	FCbObjectView Object = Root.AsObjectView();
+
+	OutDelta.Type = ReadString(Object[UTF8TEXTVIEW("type")]);
+	OutDelta.RemovedId = ReadId(Object[UTF8TEXTVIEW("removedId")]);
+	OutDelta.Version = Object[UTF8TEXTVIEW("version")].AsInt32();
+
+	FCbFieldView NodeField = Object[UTF8TEXTVIEW("node")];
+	if (NodeField.IsObject())
+	{
+		ReadNode(NodeField.AsObjectView(), OutDelta.Node.Emplace());
+	}
+	FCbFieldView ConnectionField = Object[UTF8TEXTVIEW("connection")];
+	if (ConnectionField.IsObject())
+	{
+		ReadConnection(ConnectionField.AsObjectView(), OutDelta.Connection.Emplace());
+	}
+	FCbFieldView VariableField = Object[UTF8TEXTVIEW("variable")];
+	if (VariableField.IsObject())
+	{
+		ReadVariable(VariableField.AsObjectView(), OutDelta.Variable.Emplace());
+	}
+	FCbFieldView FullStateField = Object[UTF8TEXTVIEW("fullState")];
+	if (FullStateField.IsObject())
+	{
+		ReadState(FullStateField.AsObjectView(), OutDelta.FullState.Emplace());
+	}
+
+	if (OutDelta.Type.IsEmpty())
+	{
+		// Raw blueprint state without a delta envelope
+		if (!Object[UTF8TEXTVIEW("nodes")].IsArray() && !Object[UTF8TEXTVIEW("connections")].IsArray() && !Object[UTF8TEXTVIEW("variables")].IsArray())
+		{
+			return Fail(TEXT("Body is neither a delta nor a blueprint state"));
+		}
+		OutDelta.Type = TEXT("FullSync");
+		ReadState(Object, OutDelta.FullState.Emplace());
+	}
+
+	return true;
+}
+
+void FBlueprintCbReader::ReadState(FCbObjectView Object, FBlueprintStateData& OutState)
+{
+	OutState.Name = ReadString(Object[UTF8TEXTVIEW("name")]);
+
+	FCbArrayView Nodes = Object[UTF8TEXTVIEW("nodes")].AsArrayView();
+	OutState.Nodes.Reserve(static_cast<int32>(Nodes.Num()));
+	for (FCbFieldView Node : Nodes)
+	{
+		if (Node.IsObject())
+		{
+			ReadNode(Node.AsObjectView(), OutState.Nodes.AddDefaulted_GetRef());
+		}
+	}
+
+	FCbArrayView Connections = Object[UTF8TEXTVIEW("connections")].AsArrayView();
+	OutState.Connections.Reserve(static_cast<int32>(Connections.Num()));
+	for (FCbFieldView Connection : Connections)
+	{
+		if (Connection.IsObject())
+		{
+			ReadConnection(Connection.AsObjectView(), OutState.Connections.AddDefaulted_GetRef());
+		}
+	}
+
+	FCbFieldView Variables = Object[UTF8TEXTVIEW("variables")];
+	OutState.bHasVariables = Variables.IsArray();
+	for (FCbFieldView Variable : Variables.AsArrayView())
+	{
+		if (Variable.IsObject())
+		{
+			ReadVariable(Variable.AsObjectView(), OutState.Variables.AddDefaulted_GetRef());
+		}
+	}
+}
+
+void FBlueprintCbReader::ReadNode(FCbObjectView Object, FBlueprintNodeData& OutNode)
+{
+	OutNode.Id = ReadId(Object[UTF8TEXTVIEW("id")]);
+	OutNode.Title = ReadString(Object[UTF8TEXTVIEW("title")]);
+	OutNode.Category = ReadString(Object[UTF8TEXTVIEW("category")]);
+	OutNode.Style = ReadString(Object[UTF8TEXTVIEW("style")]);
+	OutNode.bIsCompact = Object[UTF8TEXTVIEW("isCompact")].AsBool();
+	OutNode.PosX = static_cast<int32>(Object[UTF8TEXTVIEW("positionX")].AsDouble());
+	OutNode.PosY = static_cast<int32>(Object[UTF8TEXTVIEW("positionY")].AsDouble());
+	ReadPins(Object[UTF8TEXTVIEW("inputPins")].AsArrayView(), OutNode.InputPins);
+	ReadPins(Object[UTF8TEXTVIEW("outputPins")].AsArrayView(), OutNode.OutputPins);
+}
+
+void FBlueprintCbReader::ReadPins(FCbArrayView Array, TArray<FBlueprintPinData>& OutPins)
+{
+	OutPins.Reserve(static_cast<int32>(Array.Num()));
+	for (FCbFieldView Element : Array)
+	{
+		if (!Element.IsObject()) continue;
+
+		FCbObjectView Object = Element.AsObjectView();
+		FBlueprintPinData& Pin = OutPins.AddDefaulted_GetRef();
+		Pin.Id = ReadId(Object[UTF8TEXTVIEW("id")]);
+		Pin.Name = ReadString(Object[UTF8TEXTVIEW("name")]);
+		Pin.Type = ReadString(Object[UTF8TEXTVIEW("type")]);
+		Pin.SubType = ReadString(Object[UTF8TEXTVIEW("subType")]);
+		Pin.bIsConnected = Object[UTF8TEXTVIEW("isConnected")].AsBool();
+
+		FCbFieldView DefaultValue = Object[UTF8TEXTVIEW("defaultValue")];
+		Pin.bHasDefaultValue = DefaultValue.IsString() || DefaultValue.IsInteger() || DefaultValue.IsFloat() || DefaultValue.IsBool();
+		Pin.DefaultValue = ReadDefaultValue(DefaultValue);
+	}
+}
+
+void FBlueprintCbReader::ReadConnection(FCbObjectView Object, FBlueprintConnectionData& OutConnection)
+{
+	OutConnection.Id = ReadId(Object[UTF8TEXTVIEW("id")]);
+	OutConnection.SourceNodeId = ReadId(Object[UTF8TEXTVIEW("sourceNodeId")]);
+	OutConnection.SourcePinId = ReadId(Object[UTF8TEXTVIEW("sourcePinId")]);
+	OutConnection.TargetNodeId = ReadId(Object[UTF8TEXTVIEW("targetNodeId")]);
+	OutConnection.TargetPinId = ReadId(Object[UTF8TEXTVIEW("targetPinId")]);
+	OutConnection.PinType = ReadString(Object[UTF8TEXTVIEW("pinType")]);
+}
+
+void FBlueprintCbReader::ReadVariable(FCbObjectView Object, FBlueprintVariableData& OutVariable)
+{
+	OutVariable.Id = ReadId(Object[UTF8TEXTVIEW("id")]);
+	OutVariable.Name = ReadString(Object[UTF8TEXTVIEW("name")]);
+	OutVariable.Type = ReadString(Object[UTF8TEXTVIEW("type")]);
+	OutVariable.DefaultValue = ReadDefaultValue(Object[UTF8TEXTVIEW("defaultValue")]);
+	OutVariable.Category = ReadString(Object[UTF8TEXTVIEW("category")]);
+	OutVariable.bIsEditable = Object[UTF8TEXTVIEW("isEditable")].AsBool();
+}
+
+FString FBlueprintCbReader::ReadString(FCbFieldView Field)
+{
+	if (!Field.IsString())
+	{
+		return FString();
+	}
+
+	FUtf8StringView Value = Field.AsString();
+	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Value.GetData()), Value.Len());
+	return FString(Converter.Length(), Converter.Get());
+}
+
+FString FBlueprintCbReader::ReadDefaultValue(FCbFieldView Field)
+{
+	// Same strings the JSON reader makes of numeric and bool defaults
+	if (Field.IsInteger() || Field.IsFloat())
+	{
+		return FString::SanitizeFloat(Field.AsDouble(), 0);
+	}
+	if (Field.IsBool())
+	{
+		return Field.AsBool() ? TEXT("true") : TEXT("false");
+	}
+	return ReadString(Field);
+}
+
+FString FBlueprintCbReader::ReadId(FCbFieldView Field)
+{
+	// IDs go out as Uuid fields, but string IDs are accepted too
+	return Field.IsUuid() ? Field.AsUuid().ToString(EGuidFormats::DigitsWithHyphensLower) : ReadString(Field);
+}
+
+bool FBlueprintCbReader::Fail(const FString& Message)
+{
+	if (Error.IsEmpty())
+	{
+		Error = Message;
+	}
+	return false;
+}
@@ -0,0 +1,92 @@
+#include "BlueprintCbWriter.h"
+#include "Memory/MemoryView.h"
+
+void FBlueprintCbWriter::WriteObjectStart()
+{
+	Writer.BeginObject();
+}
+
+void FBlueprintCbWriter::WriteObjectEnd()
+{
+	Writer.EndObject();
+}
+
+void FBlueprintCbWriter::WriteArrayStart(const TCHAR* Key)
+{
+	SetName(Key);
+	Writer.BeginArray();
+}
+
+void FBlueprintCbWriter::WriteArrayEnd()
+{
+	Writer.EndArray();
+}
+
+void FBlueprintCbWriter::WriteValue(const TCHAR* Key, const FString& Value)
+{
+	SetName(Key);
+	Writer.AddString(FStringView(Value));
+}
+
+void FBlueprintCbWriter::WriteValue(const TCHAR* Key, const TCHAR* Value)
+{
+	SetName(Key);
+	Writer.AddString(FStringView(Value));
+}
+
+void FBlueprintCbWriter::WriteValue(const TCHAR* Key, int32 Value)
+{
+	SetName(Key);
+	Writer.AddInteger(Value);
+}
+
+void FBlueprintCbWriter::WriteValue(const TCHAR* Key, bool Value)
+{
+	SetName(Key);
+	Writer.AddBool(Value);
+}
+
+void FBlueprintCbWriter::WriteId(const TCHAR* Key, const FString& Id)
+{
+	FGuid Guid;
+	if (FGuid::Parse(Id, Guid))
+	{
+		SetName(Key);
+		Writer.AddUuid(Guid);
+	}
+	else
+	{
+		WriteValue(Key, Id);
+	}
+}
+
+void FBlueprintCbWriter::WriteObject(const FCbObject& Object)
+{
+	Writer.AddObject(Object);
+}
+
+void FBlueprintCbWriter::WriteObject(const TCHAR* Key, const FCbObjectView& Object)
+{
+	SetName(Key);
+	Writer.AddObject(Object);
+}
+
+TArray<uint8> FBlueprintCbWriter::Save() const
+{
+	TArray<uint8> Output;
+	Output.SetNumUninitialized(static_cast<int32>(Writer.GetSaveSize()));
+	Writer.Save(MakeMemoryView(Output.GetData(), Output.Num()));
+	return Output;
+}
+
+FCbObject FBlueprintCbWriter::SaveObject() const
+{
+	return Writer.Save().AsObject();
+}
+
+void FBlueprintCbWriter::SetName(const TCHAR* Key)
+{
+	// Field names are short ASCII literals; the writer copies them
+	FTCHARToUTF8 Name(Key);
+	Writer.SetName(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Name.Get()), Name.Length()));
+}
@@ -0,0 +1,547 @@
+#include "BlueprintChangeFeed.h"
+#include "BlueprintDeltaWriter.h"
+#include "BlueprintIdRegistry.h"
+#include "BlueprintJsonReader.h"
+#include "BlueprintRevisionTracker.h"
+#include "BlueprintSerializer.h"
+#include "Engine/Blueprint.h"
+#include "HttpServerResponse.h"
+
+FBlueprintChangeFeed::FBlueprintChangeFeed(FBlueprintRevisionTracker& InRevisions)
+	: Revisions(InRevisions)
+{
+	RevisionChangedHandle = Revisions.OnRevisionChanged().AddRaw(this, &FBlueprintChangeFeed::OnRevisionChanged);
+	NodeChangedHandle = Revisions.OnNodeChanged().AddRaw(this, &FBlueprintChangeFeed::OnNodeChanged);
+	StructureChangedHandle = Revisions.OnStructureChanged().AddRaw(this, &FBlueprintChangeFeed::OnStructureChanged);
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBlueprintChangeFeed::Tick), 0.02f);
+}
+
+FBlueprintChangeFeed::~FBlueprintChangeFeed()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	Revisions.OnRevisionChanged().Remove(RevisionChangedHandle);
+	Revisions.OnNodeChanged().Remove(NodeChangedHandle);
+	Revisions.OnStructureChanged().Remove(StructureChangedHandle);
+
+	for (auto& Pair : Channels)
+	{
+		DestroyChannel(*Pair.Value);
+	}
+	Channels.Empty();
+}
+
+void FBlueprintChangeFeed::Subscribe(UBlueprint* Blueprint, TOptional<uint64> LastEventId, const FHttpResultCallback& OnComplete)
+{
+	FChannel* Channel = FindOrCreateChannel(Blueprint);
+	const double Now = FPlatformTime::Seconds();
+	Channel->LastSubscribed = Now;
+
+	FWaiter& Waiter = Channel->Waiters.AddDefaulted_GetRef();
+	Waiter.LastEventId = LastEventId.Get(NextEventId - 1);
+	Waiter.Deadline = Now + PollTimeoutSeconds;
+	Waiter.OnComplete = OnComplete;
+
+	Flush(*Channel, Now, false);
+}
+
+void FBlueprintChangeFeed::Watch(UBlueprint* Blueprint)
+{
+	FChannel* Channel = FindOrCreateChannel(Blueprint);
+	Channel->LastSubscribed = FPlatformTime::Seconds();
+	++Channel->Watchers;
+}
+
+void FBlueprintChangeFeed::Unwatch(UBlueprint* Blueprint)
+{
+	if (TUniquePtr<FChannel>* Channel = Channels.Find(Blueprint))
+	{
+		// The channel lingers like an idle poll channel so a quick re-watch keeps its backlog
+		(*Channel)->Watchers = FMath::Max(0, (*Channel)->Watchers - 1);
+		(*Channel)->LastSubscribed = FPlatformTime::Seconds();
+	}
+}
+
+FBlueprintChangeFeed::FChannel* FBlueprintChangeFeed::FindOrCreateChannel(UBlueprint* Blueprint)
+{
+	if (TUniquePtr<FChannel>* Existing = Channels.Find(Blueprint))
+	{
+		return Existing->Get();
+	}
+
+	TUniquePtr<FChannel>& Channel = Channels.Add(Blueprint, MakeUnique<FChannel>());
+	Channel->Blueprint = Blueprint;
+	Channel->Serializer = MakeShared<FBlueprintSerializer>();
+	Channel->CompiledHandle = Blueprint->OnCompiled().AddRaw(this, &FBlueprintChangeFeed::OnBlueprintCompiled);
+
+	// Start watching so edits bump the revision, and take the baseline the first diff compares against
+	Revisions.GetRevision(Blueprint);
+	FBlueprintStateData Baseline;
+	if (CaptureState(*Channel, Baseline))
+	{
+		Channel->Name = MoveTemp(Baseline.Name);
+		for (FBlueprintNodeData& Node : Baseline.Nodes)
+		{
+			Channel->Nodes.Add(Node.Id, MoveTemp(Node));
+		}
+		for (const FBlueprintConnectionData& Connection : Baseline.Connections)
+		{
+			AddConnection(*Channel, Connection);
+		}
+		Channel->Variables = MoveTemp(Baseline.Variables);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Change feed opened for %s"), *Blueprint->GetName());
+	return Channel.Get();
+}
+
+void FBlueprintChangeFeed::DestroyChannel(FChannel& Channel)
+{
+	if (UBlueprint* Blueprint = Channel.Blueprint.Get())
+	{
+		Blueprint->OnCompiled().Remove(Channel.CompiledHandle);
+	}
+	Flush(Channel, FPlatformTime::Seconds(), true);
+}
+
+bool FBlueprintChangeFeed::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (auto It = Channels.CreateIterator(); It; ++It)
+	{
+		FChannel& Channel = *It.Value();
+
+		// Blueprint unloaded, or nobody has listened for a while
+		if (!Channel.Blueprint.IsValid() || (Channel.Waiters.Num() == 0 && Channel.Watchers == 0 && Now - Channel.LastSubscribed > 2.0 * PollTimeoutSeconds))
+		{
+			DestroyChannel(Channel);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Channel.bDiffPending && Now - Channel.PendingSince >= CoalesceSeconds)
+		{
+			Channel.bDiffPending = false;
+			DiffAndQueue(Channel);
+		}
+
+		// Report the compile after the edits it compiled
+		if (Channel.bCompiledPending && !Channel.bDiffPending)
+		{
+			Channel.bCompiledPending = false;
+			UBlueprint* Blueprint = Channel.Blueprint.Get();
+			QueueEvent(Channel, TEXT("compiled"), FString::Printf(TEXT("{\"name\":\"%s\",\"hasErrors\":%s}"),
+				*Blueprint->GetName(), Blueprint->Status == BS_Error ? TEXT("true") : TEXT("false")));
+		}
+
+		Flush(Channel, Now, false);
+	}
+
+	return true;
+}
+
+void FBlueprintChangeFeed::OnRevisionChanged(UBlueprint* Blueprint)
+{
+	if (TUniquePtr<FChannel>* Channel = Channels.Find(Blueprint))
+	{
+		ScheduleDiff(**Channel);
+	}
+}
+
+void FBlueprintChangeFeed::OnNodeChanged(UBlueprint* Blueprint, const UEdGraphNode* Node)
+{
+	if (TUniquePtr<FChannel>* Channel = Channels.Find(Blueprint))
+	{
+		(*Channel)->DirtyNodes.Add(FBlueprintIdRegistry::GetNodeGuid(Node));
+		ScheduleDiff(**Channel);
+	}
+}
+
+void FBlueprintChangeFeed::OnStructureChanged(UBlueprint* Blueprint)
+{
+	if (TUniquePtr<FChannel>* Channel = Channels.Find(Blueprint))
+	{
+		(*Channel)->bFullDiffPending = true;
+		ScheduleDiff(**Channel);
+	}
+}
+
+void FBlueprintChangeFeed::ScheduleDiff(FChannel& Channel)
+{
+	if (!Channel.bDiffPending)
+	{
+		Channel.bDiffPending = true;
+		Channel.PendingSince = FPlatformTime::Seconds();
+	}
+}
+
+void FBlueprintChangeFeed::OnBlueprintCompiled(UBlueprint* Blueprint)
+{
+	if (TUniquePtr<FChannel>* Channel = Channels.Find(Blueprint))
+	{
+		(*Channel)->bCompiledPending = true;
+	}
+}
+
+bool FBlueprintChangeFeed::CaptureState(FChannel& Channel, FBlueprintStateData& OutState)
+{
+	UBlueprint* Blueprint = Channel.Blueprint.Get();
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	TArray<uint8> Export = Channel.Serializer->SerializeBlueprint(Blueprint);
+	FBlueprintJsonReader Reader(Export);
+	if (!Reader.ReadBlueprintState(OutState))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Change feed could not read back export of %s: %s"),
+			*Blueprint->GetName(), *Reader.GetError());
+		return false;
+	}
+	return true;
+}
+
+bool FBlueprintChangeFeed::CaptureNodes(FChannel& Channel, const TSet<FGuid>& DirtyNodes, FBlueprintStateData& OutState, TSet<FString>& OutScope)
+{
+	UBlueprint* Blueprint = Channel.Blueprint.Get();
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	// A broken link leaves no trace on the live graph, so the nodes a dirty node used to be linked to come from the snapshot
+	FBlueprintExportQuery Query;
+	Query.Hops = 1;
+	Query.Fields = EBlueprintExportFields::All & ~EBlueprintExportFields::Variables;
+	for (const FGuid& NodeGuid : DirtyNodes)
+	{
+		const FString NodeId = NodeGuid.ToString(EGuidFormats::DigitsWithHyphensLower);
+		Query.NodeGuids.Add(NodeGuid);
+		OutScope.Add(NodeId);
+
+		for (auto It = Channel.NodeConnections.CreateConstKeyIterator(NodeId); It; ++It)
+		{
+			const FBlueprintConnectionData& Connection = Channel.Connections.FindChecked(It.Value());
+			const FString& NeighborId = Connection.SourceNodeId == NodeId ? Connection.TargetNodeId : Connection.SourceNodeId;
+			FGuid NeighborGuid;
+			if (FGuid::Parse(NeighborId, NeighborGuid))
+			{
+				Query.NodeGuids.Add(NeighborGuid);
+				OutScope.Add(NeighborId);
+			}
+		}
+	}
+
+	TArray<uint8> Export = Channel.Serializer->SerializeBlueprint(Blueprint, EBlueprintWireFormat::Json, Query);
+	FBlueprintJsonReader Reader(Export);
+	if (!Reader.ReadBlueprintState(OutState))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Change feed could not read back changed nodes of %s: %s"),
+			*Blueprint->GetName(), *Reader.GetError());
+		return false;
+	}
+
+	for (const FBlueprintNodeData& Node : OutState.Nodes)
+	{
+		OutScope.Add(Node.Id);
+	}
+	return true;
+}
+
+void FBlueprintChangeFeed::DiffAndQueue(FChannel& Channel)
+{
+	const bool bFull = Channel.bFullDiffPending;
+	const TSet<FGuid> DirtyNodes = MoveTemp(Channel.DirtyNodes);
+	Channel.DirtyNodes.Reset();
+	Channel.bFullDiffPending = false;
+
+	// Compiles and package-dirty events move the revision without changing anything the feed reports
+	if (!bFull && DirtyNodes.Num() == 0)
+	{
+		return;
+	}
+
+	FBlueprintStateData Current;
+	TSet<FString> Scope;
+	const bool bCaptured = bFull ? CaptureState(Channel, Current) : CaptureNodes(Channel, DirtyNodes, Current, Scope);
+	if (!bCaptured)
+	{
+		// The changes are still unreported; the next diff takes everything in
+		Channel.bFullDiffPending = true;
+		return;
+	}
+
+	// Snapshot records outside a partial capture are unknown, not gone
+	auto InScope = [bFull, &Scope](const FString& NodeId)
+	{
+		return bFull || Scope.Contains(NodeId);
+	};
+
+	auto PinsEqual = [](const TArray<FBlueprintPinData>& A, const TArray<FBlueprintPinData>& B)
+	{
+		if (A.Num() != B.Num()) return false;
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (A[Index].Id != B[Index].Id || A[Index].Name != B[Index].Name || A[Index].Type != B[Index].Type
+				|| A[Index].DefaultValue != B[Index].DefaultValue || A[Index].SubType != B[Index].SubType
+				|| A[Index].bIsConnected != B[Index].bIsConnected)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	auto NodesEqual = [&PinsEqual](const FBlueprintNodeData& A, const FBlueprintNodeData& B)
+	{
+		return A.Title == B.Title && A.Category == B.Category && A.Style == B.Style && A.PosX == B.PosX && A.PosY == B.PosY
+			&& A.bIsCompact == B.bIsCompact && PinsEqual(A.InputPins, B.InputPins) && PinsEqual(A.OutputPins, B.OutputPins);
+	};
+
+	auto VariablesEqual = [](const FBlueprintVariableData& A, const FBlueprintVariableData& B)
+	{
+		return A.Name == B.Name && A.Type == B.Type && A.DefaultValue == B.DefaultValue
+			&& A.Category == B.Category && A.bIsEditable == B.bIsEditable;
+	};
+
+	const int32 BacklogBefore = Channel.Backlog.Num();
+
+	// Removals first so a consumer replaying the records never sees dangling connections
+	TSet<FString> CurrentConnectionIds;
+	for (const FBlueprintConnectionData& Connection : Current.Connections)
+	{
+		CurrentConnectionIds.Add(Connection.Id);
+	}
+	TSet<FString> KnownConnectionIds;
+	if (bFull)
+	{
+		Channel.Connections.GetKeys(KnownConnectionIds);
+	}
+	else
+	{
+		for (const FString& NodeId : Scope)
+		{
+			for (auto It = Channel.NodeConnections.CreateConstKeyIterator(NodeId); It; ++It)
+			{
+				KnownConnectionIds.Add(It.Value());
+			}
+		}
+	}
+	for (const FString& ConnectionId : KnownConnectionIds)
+	{
+		const FBlueprintConnectionData& Connection = Channel.Connections.FindChecked(ConnectionId);
+		if (!CurrentConnectionIds.Contains(ConnectionId) && InScope(Connection.SourceNodeId) && InScope(Connection.TargetNodeId))
+		{
+			FBlueprintDeltaData Delta;
+			Delta.Type = TEXT("ConnectionRemoved");
+			Delta.RemovedId = ConnectionId;
+			Delta.Connection = Connection;
+			QueueDelta(Channel, MoveTemp(Delta));
+			RemoveConnection(Channel, ConnectionId);
+		}
+	}
+
+	TSet<FString> CurrentNodeIds;
+	for (const FBlueprintNodeData& Node : Current.Nodes)
+	{
+		CurrentNodeIds.Add(Node.Id);
+	}
+	TArray<FString> KnownNodeIds;
+	if (bFull)
+	{
+		Channel.Nodes.GenerateKeyArray(KnownNodeIds);
+	}
+	else
+	{
+		KnownNodeIds = Scope.Array();
+	}
+	for (const FString& NodeId : KnownNodeIds)
+	{
+		if (!CurrentNodeIds.Contains(NodeId) && Channel.Nodes.Remove(NodeId) > 0)
+		{
+			FBlueprintDeltaData Delta;
+			Delta.Type = TEXT("NodeRemoved");
+			Delta.RemovedId = NodeId;
+			QueueDelta(Channel, MoveTemp(Delta));
+		}
+	}
+
+	// Variables are only re-read by a full diff; node edits can't change them
+	if (bFull)
+	{
+		TMap<FString, const FBlueprintVariableData*> PreviousVariables;
+		for (const FBlueprintVariableData& Variable : Channel.Variables)
+		{
+			PreviousVariables.Add(Variable.Id, &Variable);
+		}
+		TSet<FString> CurrentVariableIds;
+		for (const FBlueprintVariableData& Variable : Current.Variables)
+		{
+			CurrentVariableIds.Add(Variable.Id);
+			const FBlueprintVariableData* const* Old = PreviousVariables.Find(Variable.Id);
+			if (Old && !VariablesEqual(**Old, Variable))
+			{
+				// BlueprintDelta has no VariableUpdated; a changed variable is replaced
+				FBlueprintDeltaData Delta;
+				Delta.Type = TEXT("VariableRemoved");
+				Delta.RemovedId = Variable.Id;
+				QueueDelta(Channel, MoveTemp(Delta));
+			}
+		}
+		for (const FBlueprintVariableData& Variable : Channel.Variables)
+		{
+			if (!CurrentVariableIds.Contains(Variable.Id))
+			{
+				FBlueprintDeltaData Delta;
+				Delta.Type = TEXT("VariableRemoved");
+				Delta.RemovedId = Variable.Id;
+				QueueDelta(Channel, MoveTemp(Delta));
+			}
+		}
+
+		// Then additions and updates
+		for (const FBlueprintVariableData& Variable : Current.Variables)
+		{
+			const FBlueprintVariableData* const* Old = PreviousVariables.Find(Variable.Id);
+			if (!Old || !VariablesEqual(**Old, Variable))
+			{
+				FBlueprintDeltaData Delta;
+				Delta.Type = TEXT("VariableAdded");
+				Delta.Variable = Variable;
+				QueueDelta(Channel, MoveTemp(Delta));
+			}
+		}
+		Channel.Variables = MoveTemp(Current.Variables);
+		Channel.Name = MoveTemp(Current.Name);
+	}
+
+	for (FBlueprintNodeData& Node : Current.Nodes)
+	{
+		FBlueprintNodeData* Old = Channel.Nodes.Find(Node.Id);
+		if (!Old || !NodesEqual(*Old, Node))
+		{
+			FBlueprintDeltaData Delta;
+			Delta.Type = Old ? TEXT("NodeUpdated") : TEXT("NodeAdded");
+			Delta.Node = Node;
+			QueueDelta(Channel, MoveTemp(Delta));
+			Channel.Nodes.Add(Node.Id, MoveTemp(Node));
+		}
+	}
+
+	for (const FBlueprintConnectionData& Connection : Current.Connections)
+	{
+		if (!Channel.Connections.Contains(Connection.Id))
+		{
+			FBlueprintDeltaData Delta;
+			Delta.Type = TEXT("ConnectionAdded");
+			Delta.Connection = Connection;
+			QueueDelta(Channel, MoveTemp(Delta));
+			AddConnection(Channel, Connection);
+		}
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Change feed queued %d records for %s (%s diff of %d nodes)"),
+		Channel.Backlog.Num() - BacklogBefore, *Channel.Name, bFull ? TEXT("full") : TEXT("partial"), Current.Nodes.Num());
+}
+
+void FBlueprintChangeFeed::AddConnection(FChannel& Channel, const FBlueprintConnectionData& Connection)
+{
+	Channel.Connections.Add(Connection.Id, Connection);
+	Channel.NodeConnections.Add(Connection.SourceNodeId, Connection.Id);
+	Channel.NodeConnections.Add(Connection.TargetNodeId, Connection.Id);
+}
+
+void FBlueprintChangeFeed::RemoveConnection(FChannel& Channel, const FString& ConnectionId)
+{
+	FBlueprintConnectionData Connection;
+	if (Channel.Connections.RemoveAndCopyValue(ConnectionId, Connection))
+	{
+		Channel.NodeConnections.RemoveSingle(Connection.SourceNodeId, ConnectionId);
+		Channel.NodeConnections.RemoveSingle(Connection.TargetNodeId, ConnectionId);
+	}
+}
+
+FBlueprintStateData FBlueprintChangeFeed::MakeState(const FChannel& Channel)
+{
+	FBlueprintStateData State;
+	State.Name = Channel.Name;
+	Channel.Nodes.GenerateValueArray(State.Nodes);
+	Channel.Connections.GenerateValueArray(State.Connections);
+	State.Variables = Channel.Variables;
+	State.bHasVariables = true;
+	return State;
+}
+
+void FBlueprintChangeFeed::QueueDelta(FChannel& Channel, FBlueprintDeltaData&& Delta)
+{
+	Delta.Version = static_cast<int32>(NextEventId);
+	QueueEvent(Channel, TEXT("delta"), FBlueprintDeltaWriter::Write(Delta));
+}
+
+void FBlueprintChangeFeed::QueueEvent(FChannel& Channel, const TCHAR* Name, FString&& Data)
+{
+	// Readers that fall further behind than this get a FullSync instead
+	static constexpr int32 MaxBacklog = 256;
+
+	FEvent& Event = Channel.Backlog.AddDefaulted_GetRef();
+	Event.Id = NextEventId++;
+	Event.Name = Name;
+	Event.Data = MoveTemp(Data);
+
+	if (Channel.Backlog.Num() > MaxBacklog)
+	{
+		const int32 Trimmed = Channel.Backlog.Num() - MaxBacklog;
+		Channel.TrimmedThroughId = Channel.Backlog[Trimmed - 1].Id;
+		Channel.Backlog.RemoveAt(0, Trimmed);
+	}
+
+	const FEvent& Queued = Channel.Backlog.Last();
+	ChangeEvent.Broadcast(Channel.Blueprint.Get(), Queued.Id, Queued.Name, Queued.Data);
+}
+
+void FBlueprintChangeFeed::Flush(FChannel& Channel, double Now, bool bForce)
+{
+	const uint64 LatestId = Channel.Backlog.Num() > 0 ? Channel.Backlog.Last().Id : 0;
+
+	for (int32 Index = Channel.Waiters.Num() - 1; Index >= 0; --Index)
+	{
+		const FWaiter& Waiter = Channel.Waiters[Index];
+		const bool bHasEvents = LatestId > Waiter.LastEventId;
+		if (!bHasEvents && !bForce && Now < Waiter.Deadline)
+		{
+			continue;
+		}
+
+		// Ask EventSource to reconnect immediately; the next request picks up where this one ends
+		FString Body = TEXT("retry: 10\n\n");
+		if (!bHasEvents)
+		{
+			Body += TEXT(": no changes\n\n");
+		}
+		else if (Waiter.LastEventId < Channel.TrimmedThroughId)
+		{
+			// Some of the events this client needs were trimmed; resend the whole state instead
+			FBlueprintDeltaData Resync;
+			Resync.Type = TEXT("FullSync");
+			Resync.FullState = MakeState(Channel);
+			Resync.Version = static_cast<int32>(LatestId);
+			Body += FString::Printf(TEXT("id: %llu\nevent: delta\ndata: %s\n\n"), LatestId, *FBlueprintDeltaWriter::Write(Resync));
+		}
+		else
+		{
+			for (const FEvent& Event : Channel.Backlog)
+			{
+				if (Event.Id > Waiter.LastEventId)
+				{
+					Body += FString::Printf(TEXT("id: %llu\nevent: %s\ndata: %s\n\n"), Event.Id, Event.Name, *Event.Data);
+				}
+			}
+		}
+
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Body, TEXT("text/event-stream"));
+		Response->Headers.Add(TEXT("Cache-Control"), TArray<FString>{ TEXT("no-cache") });
+		Waiter.OnComplete(MoveTemp(Response));
+		Channel.Waiters.RemoveAtSwap(Index);
+	}
+}
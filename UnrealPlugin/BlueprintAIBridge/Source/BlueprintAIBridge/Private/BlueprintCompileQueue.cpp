@@ -0,0 +1,172 @@
+#include "BlueprintCompileQueue.h"
+#include "BlueprintIdRegistry.h"
+#include "BlueprintCompilationManager.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Logging/TokenizedMessage.h"
+
+FBlueprintCompileQueue::FBlueprintCompileQueue()
+{
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBlueprintCompileQueue::Tick), 0.1f);
+}
+
+FBlueprintCompileQueue::~FBlueprintCompileQueue()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+}
+
+void FBlueprintCompileQueue::MarkDirty(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		Pending.Add(Blueprint, FPlatformTime::Seconds());
+	}
+}
+
+bool FBlueprintCompileQueue::IsPending(const UBlueprint* Blueprint) const
+{
+	return Pending.Contains(TWeakObjectPtr<UBlueprint>(const_cast<UBlueprint*>(Blueprint)));
+}
+
+void FBlueprintCompileQueue::Hold(const UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		Held.Add(TWeakObjectPtr<UBlueprint>(const_cast<UBlueprint*>(Blueprint)));
+	}
+}
+
+void FBlueprintCompileQueue::Release(const UBlueprint* Blueprint)
+{
+	Held.Remove(TWeakObjectPtr<UBlueprint>(const_cast<UBlueprint*>(Blueprint)));
+}
+
+TArray<FBlueprintCompileResult> FBlueprintCompileQueue::CompileNow(const TArray<UBlueprint*>& Blueprints)
+{
+	// Whatever else is waiting compiles in the same pass; it would only cost a second flush a moment later
+	TArray<UBlueprint*> Batch;
+	for (auto It = Pending.CreateIterator(); It; ++It)
+	{
+		if (Held.Contains(It.Key()))
+		{
+			continue;
+		}
+		if (UBlueprint* Blueprint = It.Key().Get())
+		{
+			Batch.Add(Blueprint);
+		}
+		It.RemoveCurrent();
+	}
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		Batch.AddUnique(Blueprint);
+	}
+	CompileBatch(Batch);
+
+	TArray<FBlueprintCompileResult> Results;
+	Results.Reserve(Blueprints.Num());
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		Results.Add(CollectResult(Blueprint));
+	}
+	return Results;
+}
+
+bool FBlueprintCompileQueue::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (auto It = Held.CreateIterator(); It; ++It)
+	{
+		if (!It->IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<UBlueprint*> Due;
+	for (auto It = Pending.CreateIterator(); It; ++It)
+	{
+		UBlueprint* Blueprint = It.Key().Get();
+		if (!Blueprint)
+		{
+			It.RemoveCurrent();
+		}
+		else if (Now - It.Value() >= QuietSeconds && !Held.Contains(It.Key()))
+		{
+			Due.Add(Blueprint);
+			It.RemoveCurrent();
+		}
+	}
+
+	if (Due.Num() > 0)
+	{
+		CompileBatch(Due);
+	}
+	return true;
+}
+
+void FBlueprintCompileQueue::CompileBatch(const TArray<UBlueprint*>& Batch)
+{
+	if (Batch.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Queued together, the compilation manager sorts the batch by dependency and recompiles shared dependents once
+	for (UBlueprint* Blueprint : Batch)
+	{
+		FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+	}
+	FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Compiled %d blueprint(s) in one pass (%s%s) in %.2f ms"),
+		Batch.Num(), *Batch[0]->GetName(), Batch.Num() > 1 ? TEXT(", ...") : TEXT(""),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+FBlueprintCompileResult FBlueprintCompileQueue::CollectResult(UBlueprint* Blueprint)
+{
+	FBlueprintCompileResult Result;
+	Result.Name = Blueprint->GetName();
+	Result.Path = Blueprint->GetPathName();
+
+	switch (Blueprint->Status)
+	{
+	case BS_UpToDate: Result.Status = TEXT("upToDate"); break;
+	case BS_UpToDateWithWarnings: Result.Status = TEXT("upToDateWithWarnings"); break;
+	case BS_Error: Result.Status = TEXT("error"); break;
+	default: Result.Status = TEXT("dirty"); break;
+	}
+
+	// The compiler annotates the nodes its messages mention, which is what the graph editor shows too
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* Graph : Graphs)
+	{
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node || !Node->bHasCompilerMessage)
+			{
+				continue;
+			}
+
+			FBlueprintCompileMessage Message;
+			Message.NodeId = FBlueprintIdRegistry::MakeNodeId(Node);
+			Message.NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+			Message.Message = Node->ErrorMsg;
+			if (Node->ErrorType <= EMessageSeverity::Error)
+			{
+				Result.Errors.Add(MoveTemp(Message));
+			}
+			else if (Node->ErrorType <= EMessageSeverity::Warning)
+			{
+				Result.Warnings.Add(MoveTemp(Message));
+			}
+		}
+	}
+	return Result;
+}
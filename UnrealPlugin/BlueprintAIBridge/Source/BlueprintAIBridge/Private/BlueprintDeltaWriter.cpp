@@ -0,0 +1,166 @@
+#include "BlueprintDeltaWriter.h"
+
+FString FBlueprintDeltaWriter::Write(const FBlueprintDeltaData& Delta)
+{
+	FString Output;
+	TSharedRef<FWriter> Writer = FWriter::Create(&Output);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("type"), Delta.Type);
+
+	if (Delta.Node.IsSet())
+	{
+		Writer->WriteIdentifierPrefix(TEXT("node"));
+		WriteNode(*Writer, Delta.Node.GetValue());
+	}
+	else
+	{
+		Writer->WriteNull(TEXT("node"));
+	}
+
+	if (Delta.Connection.IsSet())
+	{
+		Writer->WriteIdentifierPrefix(TEXT("connection"));
+		WriteConnection(*Writer, Delta.Connection.GetValue());
+	}
+	else
+	{
+		Writer->WriteNull(TEXT("connection"));
+	}
+
+	// Comments are not synced yet
+	Writer->WriteNull(TEXT("comment"));
+
+	if (Delta.Variable.IsSet())
+	{
+		Writer->WriteIdentifierPrefix(TEXT("variable"));
+		WriteVariable(*Writer, Delta.Variable.GetValue());
+	}
+	else
+	{
+		Writer->WriteNull(TEXT("variable"));
+	}
+
+	if (Delta.RemovedId.IsEmpty())
+	{
+		Writer->WriteNull(TEXT("removedId"));
+	}
+	else
+	{
+		Writer->WriteValue(TEXT("removedId"), Delta.RemovedId);
+	}
+
+	if (Delta.FullState.IsSet())
+	{
+		Writer->WriteIdentifierPrefix(TEXT("fullState"));
+		WriteState(*Writer, Delta.FullState.GetValue());
+	}
+	else
+	{
+		Writer->WriteNull(TEXT("fullState"));
+	}
+
+	Writer->WriteValue(TEXT("version"), Delta.Version);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Output;
+}
+
+void FBlueprintDeltaWriter::WriteState(FWriter& Writer, const FBlueprintStateData& State)
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("name"), State.Name);
+
+	Writer.WriteArrayStart(TEXT("nodes"));
+	for (const FBlueprintNodeData& Node : State.Nodes)
+	{
+		WriteNode(Writer, Node);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("connections"));
+	for (const FBlueprintConnectionData& Connection : State.Connections)
+	{
+		WriteConnection(Writer, Connection);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("comments"));
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("variables"));
+	for (const FBlueprintVariableData& Variable : State.Variables)
+	{
+		WriteVariable(Writer, Variable);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+}
+
+void FBlueprintDeltaWriter::WriteNode(FWriter& Writer, const FBlueprintNodeData& Node)
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("id"), Node.Id);
+	Writer.WriteValue(TEXT("title"), Node.Title);
+	Writer.WriteValue(TEXT("category"), Node.Category);
+	Writer.WriteValue(TEXT("style"), Node.Style);
+	Writer.WriteValue(TEXT("positionX"), Node.PosX);
+	Writer.WriteValue(TEXT("positionY"), Node.PosY);
+	Writer.WriteValue(TEXT("isCompact"), Node.bIsCompact);
+	WritePins(Writer, TEXT("inputPins"), Node.InputPins, TEXT("Input"));
+	WritePins(Writer, TEXT("outputPins"), Node.OutputPins, TEXT("Output"));
+	Writer.WriteObjectEnd();
+}
+
+void FBlueprintDeltaWriter::WritePins(FWriter& Writer, const TCHAR* Key, const TArray<FBlueprintPinData>& Pins, const TCHAR* Direction)
+{
+	Writer.WriteArrayStart(Key);
+	for (const FBlueprintPinData& Pin : Pins)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("id"), Pin.Id);
+		Writer.WriteValue(TEXT("name"), Pin.Name);
+		Writer.WriteValue(TEXT("type"), Pin.Type);
+		Writer.WriteValue(TEXT("direction"), Direction);
+		Writer.WriteValue(TEXT("isConnected"), Pin.bIsConnected);
+		if (Pin.bHasDefaultValue)
+		{
+			Writer.WriteValue(TEXT("defaultValue"), Pin.DefaultValue);
+		}
+		if (!Pin.SubType.IsEmpty())
+		{
+			Writer.WriteValue(TEXT("subType"), Pin.SubType);
+		}
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+}
+
+void FBlueprintDeltaWriter::WriteConnection(FWriter& Writer, const FBlueprintConnectionData& Connection)
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("id"), Connection.Id);
+	Writer.WriteValue(TEXT("sourceNodeId"), Connection.SourceNodeId);
+	Writer.WriteValue(TEXT("sourcePinId"), Connection.SourcePinId);
+	Writer.WriteValue(TEXT("targetNodeId"), Connection.TargetNodeId);
+	Writer.WriteValue(TEXT("targetPinId"), Connection.TargetPinId);
+	Writer.WriteValue(TEXT("pinType"), Connection.PinType);
+	Writer.WriteObjectEnd();
+}
+
+void FBlueprintDeltaWriter::WriteVariable(FWriter& Writer, const FBlueprintVariableData& Variable)
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("id"), Variable.Id);
+	Writer.WriteValue(TEXT("name"), Variable.Name);
+	Writer.WriteValue(TEXT("type"), Variable.Type);
+	if (!Variable.DefaultValue.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("defaultValue"), Variable.DefaultValue);
+	}
+	Writer.WriteValue(TEXT("category"), Variable.Category);
+	Writer.WriteValue(TEXT("isEditable"), Variable.bIsEditable);
+	Writer.WriteObjectEnd();
+}
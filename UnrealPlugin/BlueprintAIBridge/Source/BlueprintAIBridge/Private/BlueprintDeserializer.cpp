@@ -1,9 +1,14 @@
 #include "BlueprintDeserializer.h"
+#include "BlueprintCompileQueue.h"
+#include "BlueprintFunctionIndex.h"
+#include "BlueprintIdRegistry.h"
+#include "BlueprintSerializer.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraphSchema_K2.h"
+#include "K2Node.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_Event.h"
 #include "K2Node_CustomEvent.h"
@@ -15,122 +20,1108 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "GameFramework/Actor.h"
-#include "UObject/UObjectIterator.h"
 
-bool FBlueprintDeserializer::ApplyFullSync(UBlueprint* Blueprint, const TSharedPtr<FJsonObject>& JsonState)
+/** A full sync split into small steps; pointers it keeps across steps are weak, since frames may pass in between */
+struct FBlueprintDeserializer::FFullSyncTask
 {
-	if (!Blueprint || !JsonState.IsValid())
+	enum class EPhase : uint8
 	{
+		Preparing,
+		Removing,
+		Nodes,
+		ResolvingLinks,
+		BreakingLinks,
+		MakingLinks,
+		Compiling,
+		Done
+	};
+
+	/** (source node, source pin, target node, target pin) GUIDs; identifies a link without holding pin pointers */
+	using FLinkKey = TTuple<FGuid, FGuid, FGuid, FGuid>;
+
+	static FLinkKey MakeLinkKey(const UEdGraphPin* SourcePin, const UEdGraphPin* TargetPin)
+	{
+		return FLinkKey(SourcePin->GetOwningNode()->NodeGuid, SourcePin->PinId, TargetPin->GetOwningNode()->NodeGuid, TargetPin->PinId);
+	}
+
+	/** Keep the wires on one end of a connection that didn't resolve: the pin if it resolved, else the whole node */
+	void ProtectEndpoint(const UEdGraphNode* Node, const UEdGraphPin* Pin)
+	{
+		if (Pin)
+		{
+			ProtectedPins.Add(TPair<FGuid, FGuid>(Node->NodeGuid, Pin->PinId));
+		}
+		else if (Node)
+		{
+			ProtectedNodes.Add(Node->NodeGuid);
+		}
+	}
+
+	bool IsProtected(const UEdGraphPin* Pin) const
+	{
+		const FGuid& NodeGuid = Pin->GetOwningNode()->NodeGuid;
+		return ProtectedNodes.Contains(NodeGuid) || ProtectedPins.Contains(TPair<FGuid, FGuid>(NodeGuid, Pin->PinId));
+	}
+
+	TWeakObjectPtr<UBlueprint> Blueprint;
+	/** Event graph, where nodes the blueprint doesn't have yet are created */
+	TWeakObjectPtr<UEdGraph> Graph;
+	/** Every graph an export covers; these are the graphs reconciled against the payload */
+	TArray<TWeakObjectPtr<UEdGraph>> Graphs;
+	FBlueprintStateData State;
+	EPhase Phase = EPhase::Preparing;
+	/** Position within the current phase's work list */
+	int32 Cursor = 0;
+
+	/** Incoming node ID -> live node */
+	TMap<FString, TWeakObjectPtr<UEdGraphNode>> NodeMap;
+	/** Every live node of the blueprint by GUID, kept current as nodes are removed and created */
+	FNodeIndex LiveNodes;
+	TArray<TWeakObjectPtr<UEdGraphNode>> NodesToRemove;
+	/** Live nodes the payload kept, whose links are checked against it */
+	TArray<TWeakObjectPtr<UEdGraphNode>> KeptNodes;
+	/** This sync's PinNameMap, swapped in while it steps */
+	TMap<FString, TMap<FString, FString>> PinNames;
+
+	TArray<TPair<FEdGraphPinReference, FEdGraphPinReference>> DesiredLinks;
+	TSet<FLinkKey> DesiredLinkKeys;
+	TSet<FLinkKey> ExistingLinkKeys;
+	/** Endpoints of payload connections that failed to resolve; their existing links may be the ones the payload meant */
+	TSet<FGuid> ProtectedNodes;
+	TSet<TPair<FGuid, FGuid>> ProtectedPins;
+
+	int32 NodesAdded = 0;
+	int32 NodesRemoved = 0;
+	int32 NodesUpdated = 0;
+	int32 LinksWired = 0;
+	int32 LinksBroken = 0;
+	int32 LinksFailed = 0;
+	/** Variables whose metadata changed without a layout change */
+	int32 VariablesUpdated = 0;
+	bool bStructural = false;
+	bool bSuccess = true;
+
+	double StartTime = 0.0;
+	FOnApplyFinished OnFinished;
+};
+
+FBlueprintDeserializer::FBlueprintDeserializer(FBlueprintCompileQueue& InCompiles)
+	: Compiles(InCompiles)
+{
+}
+
+FBlueprintDeserializer::~FBlueprintDeserializer()
+{
+	// Unfinished sliced syncs are dropped along with their callbacks
+	for (const TPair<TWeakObjectPtr<UBlueprint>, TSharedRef<FFullSyncTask>>& Sync : SlicedSyncs)
+	{
+		Compiles.Release(Sync.Key.Get());
+	}
+	if (SliceTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SliceTickHandle);
+	}
+}
+
+bool FBlueprintDeserializer::ApplyFullSync(UBlueprint* Blueprint, const FBlueprintStateData& State)
+{
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	TSharedPtr<FFullSyncTask> Task = BeginFullSync(Blueprint, FBlueprintStateData(State));
+	if (!Task.IsValid())
+	{
+		return false;
+	}
+
+	StepFullSync(*Task, TNumericLimits<double>::Max());
+	return Task->bSuccess;
+}
+
+bool FBlueprintDeserializer::ApplyFullSyncSliced(UBlueprint* Blueprint, FBlueprintStateData&& State, FOnApplyFinished&& OnFinished)
+{
+	if (!Blueprint || IsApplying(Blueprint))
+	{
+		return false;
+	}
+
+	TSharedPtr<FFullSyncTask> Task = BeginFullSync(Blueprint, MoveTemp(State));
+	if (!Task.IsValid())
+	{
+		return false;
+	}
+	Task->OnFinished = MoveTemp(OnFinished);
+	SlicedSyncs.Add(Blueprint, Task.ToSharedRef());
+	// An earlier edit's queued compile must not run on the half-applied graph between slices
+	Compiles.Hold(Blueprint);
+
+	// Zero delay: one slice every frame until the queue drains
+	if (!SliceTickHandle.IsValid())
+	{
+		SliceTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBlueprintDeserializer::TickSlicedSyncs), 0.0f);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Applying full sync to %s in slices (%d nodes, %d connections)"),
+		*Blueprint->GetName(), Task->State.Nodes.Num(), Task->State.Connections.Num());
+	return true;
+}
+
+bool FBlueprintDeserializer::CancelSlicedSync(const UBlueprint* Blueprint)
+{
+	const TWeakObjectPtr<UBlueprint> Key(const_cast<UBlueprint*>(Blueprint));
+	const TSharedRef<FFullSyncTask>* Found = SlicedSyncs.Find(Key);
+	if (!Found || (*Found)->Phase >= FFullSyncTask::EPhase::Compiling)
+	{
+		return false;
+	}
+
+	TSharedRef<FFullSyncTask> Task = *Found;
+	SlicedSyncs.Remove(Key);
+
+	UBlueprint* Live = Task->Blueprint.Get();
+	Compiles.Release(Live);
+	const bool bTouched = Task->bStructural || Task->VariablesUpdated > 0 || Task->NodesAdded > 0 || Task->NodesRemoved > 0 || Task->NodesUpdated > 0
+		|| Task->LinksWired > 0 || Task->LinksBroken > 0;
+	if (Live && Task->bStructural)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Live);
+	}
+	else if (Live && bTouched)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Live);
+	}
+	if (Live && bTouched)
+	{
+		Compiles.MarkDirty(Live);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Cancelled sliced full sync to %s (%d added, %d removed, %d links wired before stopping)"),
+		Live ? *Live->GetName() : TEXT("<unloaded>"), Task->NodesAdded, Task->NodesRemoved, Task->LinksWired);
+	return true;
+}
+
+bool FBlueprintDeserializer::IsApplying(const UBlueprint* Blueprint) const
+{
+	return SlicedSyncs.Contains(TWeakObjectPtr<UBlueprint>(const_cast<UBlueprint*>(Blueprint)));
+}
+
+bool FBlueprintDeserializer::GetApplyProgress(const UBlueprint* Blueprint, FBlueprintApplyProgress& OutProgress) const
+{
+	const TSharedRef<FFullSyncTask>* Found = SlicedSyncs.Find(TWeakObjectPtr<UBlueprint>(const_cast<UBlueprint*>(Blueprint)));
+	if (!Found)
+	{
+		return false;
+	}
+
+	using EPhase = FFullSyncTask::EPhase;
+	const FFullSyncTask& Task = Found->Get();
+	switch (Task.Phase)
+	{
+	case EPhase::Preparing: OutProgress.Phase = TEXT("preparing"); break;
+	case EPhase::Removing: OutProgress.Phase = TEXT("removing"); break;
+	case EPhase::Nodes: OutProgress.Phase = TEXT("nodes"); break;
+	case EPhase::ResolvingLinks:
+	case EPhase::BreakingLinks:
+	case EPhase::MakingLinks: OutProgress.Phase = TEXT("links"); break;
+	default: OutProgress.Phase = TEXT("compiling"); break;
+	}
+	OutProgress.NodesTotal = Task.State.Nodes.Num();
+	OutProgress.NodesProcessed = Task.Phase < EPhase::Nodes ? 0 : Task.Phase == EPhase::Nodes ? Task.Cursor : OutProgress.NodesTotal;
+	OutProgress.NodesCreated = Task.NodesAdded;
+	OutProgress.LinksWired = Task.LinksWired;
+	OutProgress.LinksTotal = Task.State.Connections.Num();
+	OutProgress.ElapsedSeconds = FPlatformTime::Seconds() - Task.StartTime;
+	return true;
+}
+
+bool FBlueprintDeserializer::TickSlicedSyncs(float DeltaTime)
+{
+	const double Budget = SliceBudgetSeconds / FMath::Max(SlicedSyncs.Num(), 1);
+
+	TArray<TSharedRef<FFullSyncTask>> Finished;
+	for (auto It = SlicedSyncs.CreateIterator(); It; ++It)
+	{
+		if (StepFullSync(It.Value().Get(), Budget))
+		{
+			Compiles.Release(It.Key().Get());
+			Finished.Add(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+
+	// Callbacks run after the map is settled, so they are free to start another sync
+	for (const TSharedRef<FFullSyncTask>& Task : Finished)
+	{
+		Task->OnFinished(Task->bSuccess);
+	}
+
+	if (SlicedSyncs.Num() == 0)
+	{
+		SliceTickHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+TSharedPtr<FBlueprintDeserializer::FFullSyncTask> FBlueprintDeserializer::BeginFullSync(UBlueprint* Blueprint, FBlueprintStateData&& State)
+{
+	UEdGraph* EventGraph = GetEventGraph(Blueprint);
+	if (!EventGraph)
+	{
+		return nullptr;
+	}
+
+	RefreshedSkeletons.Remove(Blueprint);
+
+	TSharedRef<FFullSyncTask> Task = MakeShared<FFullSyncTask>();
+	Task->Blueprint = Blueprint;
+	Task->Graph = EventGraph;
+	TArray<UEdGraph*> Graphs;
+	FBlueprintSerializer::GatherGraphs(Blueprint, FString(), Graphs);
+	Task->Graphs.Append(Graphs);
+	Task->State = MoveTemp(State);
+	Task->StartTime = FPlatformTime::Seconds();
+	return Task;
+}
+
+bool FBlueprintDeserializer::StepFullSync(FFullSyncTask& Task, double BudgetSeconds)
+{
+	using EPhase = FFullSyncTask::EPhase;
+
+	UBlueprint* Blueprint = Task.Blueprint.Get();
+	UEdGraph* EventGraph = Task.Graph.Get();
+	if (!Blueprint || !EventGraph)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Blueprint went away during a sliced full sync"));
+		Task.bSuccess = false;
+		Task.Phase = EPhase::Done;
+		return true;
+	}
+
+	// ResolvePin reads PinNameMap; give it this sync's pin names while the step runs
+	Swap(PinNameMap, Task.PinNames);
+
+	const FBlueprintStateData& State = Task.State;
+	const double Deadline = BudgetSeconds >= TNumericLimits<double>::Max() ? BudgetSeconds : FPlatformTime::Seconds() + BudgetSeconds;
+	while (Task.Phase != EPhase::Done)
+	{
+		switch (Task.Phase)
+		{
+		case EPhase::Preparing:
+		{
+			// Sync member variables before node creation, so Get/Set nodes can resolve
+			if (State.bHasVariables)
+			{
+				const FVariableSyncResult Sync = SyncVariables(Blueprint, State.Variables);
+				Task.bStructural |= Sync.IsStructural();
+				Task.VariablesUpdated += Sync.Updated;
+			}
+
+			// Seed the node map with the nodes that already exist, in every graph an export covers
+			IndexNodes(Blueprint, Task.LiveNodes);
+			TArray<UEdGraph*> Graphs;
+			for (const TWeakObjectPtr<UEdGraph>& Graph : Task.Graphs)
+			{
+				if (UEdGraph* Live = Graph.Get())
+				{
+					Graphs.Add(Live);
+				}
+			}
+			TMap<FString, UEdGraphNode*> Matched;
+			MatchExistingNodes(Graphs, EventGraph, State.Nodes, Matched);
+			TSet<UEdGraphNode*> MatchedNodes;
+			for (const auto& Pair : Matched)
+			{
+				Task.NodeMap.Add(Pair.Key, Pair.Value);
+				MatchedNodes.Add(Pair.Value);
+				Task.KeptNodes.Add(Pair.Value);
+			}
+
+			// Remove exported nodes the payload no longer contains (except the default event nodes we can't remove);
+			// comments and other non-K2 nodes are never exported, so the payload can't speak for them
+			for (UEdGraph* Graph : Graphs)
+			{
+				for (UEdGraphNode* Node : Graph->Nodes)
+				{
+					if (Cast<UK2Node>(Node) && !MatchedNodes.Contains(Node) && Node->CanUserDeleteNode())
+					{
+						Task.NodesToRemove.Add(Node);
+					}
+				}
+			}
+			Task.Phase = EPhase::Removing;
+			break;
+		}
+
+		case EPhase::Removing:
+			if (Task.Cursor < Task.NodesToRemove.Num())
+			{
+				if (UEdGraphNode* Node = Task.NodesToRemove[Task.Cursor].Get())
+				{
+					Task.LiveNodes.Remove(FBlueprintIdRegistry::GetNodeGuid(Node));
+					FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+					Task.NodesRemoved++;
+				}
+				Task.Cursor++;
+			}
+			else
+			{
+				Task.Phase = EPhase::Nodes;
+				Task.Cursor = 0;
+			}
+			break;
+
+		case EPhase::Nodes:
+			// Update matched nodes in place and create the rest
+			if (Task.Cursor < State.Nodes.Num())
+			{
+				const FBlueprintNodeData& NodeData = State.Nodes[Task.Cursor++];
+				if (const TWeakObjectPtr<UEdGraphNode>* Existing = Task.NodeMap.Find(NodeData.Id))
+				{
+					UEdGraphNode* Node = Existing->Get();
+					if (!Node)
+					{
+						break;
+					}
+					RecordPinNames(NodeData);
+
+					bool bChanged = false;
+					if (Node->NodePosX != NodeData.PosX || Node->NodePosY != NodeData.PosY)
+					{
+						Node->Modify();
+						Node->NodePosX = NodeData.PosX;
+						Node->NodePosY = NodeData.PosY;
+						bChanged = true;
+					}
+					if (ApplyPinDefaults(Node, NodeData))
+					{
+						bChanged = true;
+					}
+					Task.NodesUpdated += bChanged ? 1 : 0;
+					break;
+				}
+
+				UEdGraphNode* NewNode = CreateNodeFromData(Blueprint, EventGraph, Task.LiveNodes, NodeData);
+				if (NewNode)
+				{
+					ApplyPinDefaults(NewNode, NodeData);
+					Task.NodeMap.Add(NodeData.Id, NewNode);
+					Task.NodesAdded++;
+				}
+			}
+			else
+			{
+				Task.Phase = EPhase::ResolvingLinks;
+				Task.Cursor = 0;
+			}
+			break;
+
+		case EPhase::ResolvingLinks:
+			// Resolve the links the payload asks for; a payload without connections leaves the graph unlinked, as before
+			if (Task.Cursor < State.Connections.Num())
+			{
+				const FBlueprintConnectionData& Connection = State.Connections[Task.Cursor++];
+				const TWeakObjectPtr<UEdGraphNode>* SourceNode = Task.NodeMap.Find(Connection.SourceNodeId);
+				const TWeakObjectPtr<UEdGraphNode>* TargetNode = Task.NodeMap.Find(Connection.TargetNodeId);
+				if (!SourceNode || !TargetNode || !SourceNode->IsValid() || !TargetNode->IsValid())
+				{
+					UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Connection references missing node (source=%s, target=%s)"),
+						*Connection.SourceNodeId, *Connection.TargetNodeId);
+					if (SourceNode && SourceNode->IsValid())
+					{
+						Task.ProtectEndpoint(SourceNode->Get(), ResolvePin(SourceNode->Get(), Connection.SourceNodeId, Connection.SourcePinId, Connection.PinType, EGPD_Output));
+					}
+					if (TargetNode && TargetNode->IsValid())
+					{
+						Task.ProtectEndpoint(TargetNode->Get(), ResolvePin(TargetNode->Get(), Connection.TargetNodeId, Connection.TargetPinId, Connection.PinType, EGPD_Input));
+					}
+					Task.LinksFailed++;
+					break;
+				}
+
+				UEdGraphPin* SourcePin = nullptr;
+				UEdGraphPin* TargetPin = nullptr;
+				if (!ResolveConnectionPins(Connection, SourceNode->Get(), TargetNode->Get(), SourcePin, TargetPin))
+				{
+					Task.ProtectEndpoint(SourceNode->Get(), SourcePin);
+					Task.ProtectEndpoint(TargetNode->Get(), TargetPin);
+					Task.LinksFailed++;
+					break;
+				}
+				RecordConnection(Connection.Id, SourcePin, TargetPin);
+
+				bool bDuplicate = false;
+				Task.DesiredLinkKeys.Add(FFullSyncTask::MakeLinkKey(SourcePin, TargetPin), &bDuplicate);
+				if (!bDuplicate)
+				{
+					Task.DesiredLinks.Emplace(FEdGraphPinReference(SourcePin), FEdGraphPinReference(TargetPin));
+				}
+			}
+			else
+			{
+				Task.Phase = EPhase::BreakingLinks;
+				Task.Cursor = 0;
+			}
+			break;
+
+		case EPhase::BreakingLinks:
+			// Break links the payload no longer has, one kept node at a time; links on unresolved endpoints stay as they are
+			if (Task.Cursor < Task.KeptNodes.Num())
+			{
+				UEdGraphNode* Node = Task.KeptNodes[Task.Cursor++].Get();
+				if (!Node)
+				{
+					break;
+				}
+
+				for (UEdGraphPin* Pin : Node->Pins)
+				{
+					if (Pin->Direction != EGPD_Output) continue;
+
+					for (UEdGraphPin* LinkedPin : TArray<UEdGraphPin*>(Pin->LinkedTo))
+					{
+						const FFullSyncTask::FLinkKey Key = FFullSyncTask::MakeLinkKey(Pin, LinkedPin);
+						if (Task.DesiredLinkKeys.Contains(Key))
+						{
+							Task.ExistingLinkKeys.Add(Key);
+						}
+						else if (!Task.IsProtected(Pin) && !Task.IsProtected(LinkedPin))
+						{
+							Pin->BreakLinkTo(LinkedPin);
+							Task.LinksBroken++;
+						}
+					}
+				}
+			}
+			else
+			{
+				Task.Phase = EPhase::MakingLinks;
+				Task.Cursor = 0;
+			}
+			break;
+
+		case EPhase::MakingLinks:
+			// Make the ones that are missing
+			if (Task.Cursor < Task.DesiredLinks.Num())
+			{
+				const TPair<FEdGraphPinReference, FEdGraphPinReference>& Link = Task.DesiredLinks[Task.Cursor++];
+				UEdGraphPin* SourcePin = Link.Key.Get();
+				UEdGraphPin* TargetPin = Link.Value.Get();
+				if (!SourcePin || !TargetPin)
+				{
+					Task.LinksFailed++;
+				}
+				else if (!Task.ExistingLinkKeys.Contains(FFullSyncTask::MakeLinkKey(SourcePin, TargetPin)))
+				{
+					SourcePin->MakeLinkTo(TargetPin);
+					Task.LinksWired++;
+				}
+			}
+			else
+			{
+				UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Wired %d connections, broke %d (%d failed)"),
+					Task.LinksWired, Task.LinksBroken, Task.LinksFailed);
+				if (Task.LinksFailed > 0)
+				{
+					// The graph no longer matches the payload, so the caller has to know
+					Task.bSuccess = false;
+				}
+				Task.Phase = EPhase::Compiling;
+			}
+			break;
+
+		case EPhase::Compiling:
+			FinishFullSync(Task, Blueprint);
+			Task.Phase = EPhase::Done;
+			break;
+
+		default:
+			break;
+		}
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	// A finished sync leaves its pin names behind for the deltas that follow it, replacing the previous sync's
+	if (Task.Phase != EPhase::Done)
+	{
+		Swap(PinNameMap, Task.PinNames);
+	}
+	return Task.Phase == EPhase::Done;
+}
+
+void FBlueprintDeserializer::FinishFullSync(FFullSyncTask& Task, UBlueprint* Blueprint)
+{
+	const int32 LinksChanged = Task.LinksWired + Task.LinksBroken;
+	if (!Task.bStructural && Task.VariablesUpdated == 0 && Task.NodesAdded == 0 && Task.NodesRemoved == 0 && Task.NodesUpdated == 0
+		&& LinksChanged == 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: %s is already up to date, nothing to compile"), *Blueprint->GetName());
+		return;
+	}
+
+	// The compile waits for the queue's quiet period, so a burst of applies compiles once
+	if (Task.bStructural)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	}
+	else
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	}
+	Compiles.MarkDirty(Blueprint);
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Applied full sync to %s (%d added, %d removed, %d updated, %d links changed) in %.2f ms"),
+		*Blueprint->GetName(), Task.NodesAdded, Task.NodesRemoved, Task.NodesUpdated, LinksChanged,
+		(FPlatformTime::Seconds() - Task.StartTime) * 1000.0);
+}
+
+void FBlueprintDeserializer::MatchExistingNodes(const TArray<UEdGraph*>& Graphs, UEdGraph* EventGraph,
+	const TArray<FBlueprintNodeData>& IncomingNodes, TMap<FString, UEdGraphNode*>& OutMatched) const
+{
+	// Keyed per graph: a GUID can repeat across graphs (a duplicated function), never within one
+	TMap<TPair<const UEdGraph*, FGuid>, UEdGraphNode*> LiveByGuid;
+	for (UEdGraph* Graph : Graphs)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Cast<UK2Node>(Node))
+			{
+				LiveByGuid.Add(TPair<const UEdGraph*, FGuid>(Graph, FBlueprintIdRegistry::GetNodeGuid(Node)), Node);
+			}
+		}
+	}
+
+	// First pass: stable IDs. A node whose title changed is a different function and gets recreated.
+	TArray<const FBlueprintNodeData*> Unmatched;
+	for (const FBlueprintNodeData& NodeData : IncomingNodes)
+	{
+		FGuid NodeGuid;
+		bool bMatched = false;
+		if (FGuid::Parse(NodeData.Id, NodeGuid))
+		{
+			for (UEdGraph* Graph : Graphs)
+			{
+				const TPair<const UEdGraph*, FGuid> Key(Graph, NodeGuid);
+				UEdGraphNode** Live = LiveByGuid.Find(Key);
+				if (Live && (*Live)->GetNodeTitle(ENodeTitleType::FullTitle).ToString() == NodeData.Title)
+				{
+					OutMatched.Add(NodeData.Id, *Live);
+					LiveByGuid.Remove(Key);
+					bMatched = true;
+					break;
+				}
+			}
+		}
+		if (!bMatched)
+		{
+			Unmatched.Add(&NodeData);
+		}
+	}
+
+	if (Unmatched.Num() == 0 || LiveByGuid.Num() == 0)
+	{
+		return;
+	}
+
+	// Second pass: (style, title, position) for nodes whose IDs the backend doesn't know yet. Those are nodes it
+	// created, which only ever go into the event graph, so only event graph nodes are candidates.
+	auto MakeSignature = [](const FString& Style, const FString& Title, int32 PosX, int32 PosY)
+	{
+		return FString::Printf(TEXT("%s|%s|%d|%d"), *Style, *Title, PosX, PosY);
+	};
+
+	TMultiMap<FString, UEdGraphNode*> LiveBySignature;
+	for (const auto& Pair : LiveByGuid)
+	{
+		if (Pair.Key.Key != EventGraph)
+		{
+			continue;
+		}
+		UK2Node* K2Node = CastChecked<UK2Node>(Pair.Value);
+		LiveBySignature.Add(MakeSignature(FBlueprintSerializer::MapNodeStyle(K2Node),
+			K2Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString(), K2Node->NodePosX, K2Node->NodePosY), K2Node);
+	}
+
+	for (const FBlueprintNodeData* NodeData : Unmatched)
+	{
+		FString Signature = MakeSignature(NodeData->Style, NodeData->Title, NodeData->PosX, NodeData->PosY);
+		if (UEdGraphNode** Live = LiveBySignature.Find(Signature))
+		{
+			UEdGraphNode* Node = *Live;
+			OutMatched.Add(NodeData->Id, Node);
+			LiveBySignature.Remove(Signature, Node);
+		}
+	}
+}
+
+bool FBlueprintDeserializer::ApplyDelta(UBlueprint* Blueprint, const FBlueprintDeltaData& Delta)
+{
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	const FString& Type = Delta.Type;
+	if (Type == TEXT("FullSync"))
+	{
+		if (!Delta.FullState.IsSet())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: FullSync delta is missing 'fullState'"));
+			return false;
+		}
+		return ApplyFullSync(Blueprint, Delta.FullState.GetValue());
+	}
+
+	RefreshedSkeletons.Remove(Blueprint);
+
+	bool bSuccess = false;
+	bool bModified = false;
+	bool bStructural = false;
+	FNodeIndex Nodes;
+
+	if (Type == TEXT("NodeAdded") && Delta.Node.IsSet())
+	{
+		IndexNodes(Blueprint, Nodes);
+		bSuccess = ApplyNodeAdded(Blueprint, Nodes, Delta.Node.GetValue(), bModified);
+	}
+	else if (Type == TEXT("NodeRemoved"))
+	{
+		IndexNodes(Blueprint, Nodes);
+		bSuccess = ApplyNodeRemoved(Blueprint, Nodes, Delta.RemovedId, bModified);
+	}
+	else if (Type == TEXT("NodeUpdated") && Delta.Node.IsSet())
+	{
+		IndexNodes(Blueprint, Nodes);
+		bSuccess = ApplyNodeUpdated(Blueprint, Nodes, Delta.Node.GetValue(), bModified);
+	}
+	else if (Type == TEXT("ConnectionAdded") && Delta.Connection.IsSet())
+	{
+		IndexNodes(Blueprint, Nodes);
+		bSuccess = ApplyConnectionAdded(Blueprint, Nodes, Delta.Connection.GetValue(), bModified);
+	}
+	else if (Type == TEXT("ConnectionRemoved"))
+	{
+		const FString& ConnectionId = Delta.RemovedId.IsEmpty() && Delta.Connection.IsSet() ? Delta.Connection->Id : Delta.RemovedId;
+		bSuccess = ApplyConnectionRemoved(Blueprint, ConnectionId, bModified);
+	}
+	else if (Type == TEXT("VariableAdded") && Delta.Variable.IsSet())
+	{
+		bSuccess = ApplyVariableAdded(Blueprint, Delta.Variable.GetValue(), bModified);
+		bStructural = bModified;
+	}
+	else if (Type == TEXT("VariableRemoved"))
+	{
+		bSuccess = ApplyVariableRemoved(Blueprint, Delta.RemovedId, bModified);
+		bStructural = bModified;
+	}
+	else if (Type == TEXT("CommentAdded") || Type == TEXT("CommentRemoved"))
+	{
+		// Comments are not exported by the serializer yet, so there is nothing to keep in sync
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Ignoring %s delta (comments are not synced)"), *Type);
+		bSuccess = true;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Unsupported or incomplete delta '%s'"), *Type);
+		return false;
+	}
+
+	if (bModified)
+	{
+		if (bStructural)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		}
+		else
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		}
+		Compiles.MarkDirty(Blueprint);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Applied %s delta to %s (%s)"),
+		*Type, *Blueprint->GetName(), bModified ? TEXT("modified") : TEXT("no changes"));
+
+	return bSuccess;
+}
+
+bool FBlueprintDeserializer::ApplyNodeAdded(UBlueprint* Blueprint, FNodeIndex& Nodes, const FBlueprintNodeData& NodeData, bool& bOutModified)
+{
+	if (FindNodeById(Nodes, NodeData.Id))
+	{
+		// Already applied (e.g. a retried request); bring it in line instead of duplicating it
+		return ApplyNodeUpdated(Blueprint, Nodes, NodeData, bOutModified);
+	}
+
+	UEdGraph* EventGraph = GetEventGraph(Blueprint);
+	if (!EventGraph)
+	{
+		return false;
+	}
+
+	UEdGraphNode* NewNode = CreateNodeFromData(Blueprint, EventGraph, Nodes, NodeData);
+	if (!NewNode)
+	{
+		return false;
+	}
+
+	ApplyPinDefaults(NewNode, NodeData);
+	bOutModified = true;
+	return true;
+}
+
+bool FBlueprintDeserializer::ApplyNodeRemoved(UBlueprint* Blueprint, FNodeIndex& Nodes, const FString& NodeId, bool& bOutModified)
+{
+	UEdGraphNode* Node = FindNodeById(Nodes, NodeId);
+	if (!Node)
+	{
+		// Nothing to remove; treat as already applied
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: NodeRemoved target '%s' not found"), *NodeId);
+		return true;
+	}
+
+	if (!Node->CanUserDeleteNode())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Node '%s' cannot be deleted"), *NodeId);
+		return false;
+	}
+
+	Nodes.Remove(FBlueprintIdRegistry::GetNodeGuid(Node));
+	FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+	PinNameMap.Remove(NodeId);
+	bOutModified = true;
+	return true;
+}
+
+bool FBlueprintDeserializer::ApplyNodeUpdated(UBlueprint* Blueprint, FNodeIndex& Nodes, const FBlueprintNodeData& NodeData, bool& bOutModified)
+{
+	UEdGraphNode* Node = FindNodeById(Nodes, NodeData.Id);
+	if (!Node)
+	{
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: NodeUpdated target '%s' not found, adding it"), *NodeData.Id);
+		return ApplyNodeAdded(Blueprint, Nodes, NodeData, bOutModified);
+	}
+
+	if (NodeData.Title != Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString() && Node->CanUserDeleteNode())
+	{
+		// A different function/event: replace the node but keep its ID and any links whose pins still exist
+		UEdGraph* Graph = Node->GetGraph();
+		TArray<TPair<FName, TArray<UEdGraphPin*>>> InputLinks;
+		TArray<TPair<FName, TArray<UEdGraphPin*>>> OutputLinks;
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->LinkedTo.Num() > 0)
+			{
+				auto& Links = Pin->Direction == EGPD_Input ? InputLinks : OutputLinks;
+				Links.Emplace(Pin->PinName, Pin->LinkedTo);
+			}
+		}
+
+		Nodes.Remove(FBlueprintIdRegistry::GetNodeGuid(Node));
+		FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+		PinNameMap.Remove(NodeData.Id);
+
+		UEdGraphNode* NewNode = CreateNodeFromData(Blueprint, Graph, Nodes, NodeData);
+		bOutModified = true;
+		if (!NewNode)
+		{
+			return false;
+		}
+
+		for (const auto& Link : InputLinks)
+		{
+			if (UEdGraphPin* Pin = NewNode->FindPin(Link.Key, EGPD_Input))
+			{
+				for (UEdGraphPin* Other : Link.Value)
+				{
+					Pin->MakeLinkTo(Other);
+				}
+			}
+		}
+		for (const auto& Link : OutputLinks)
+		{
+			if (UEdGraphPin* Pin = NewNode->FindPin(Link.Key, EGPD_Output))
+			{
+				for (UEdGraphPin* Other : Link.Value)
+				{
+					Pin->MakeLinkTo(Other);
+				}
+			}
+		}
+
+		ApplyPinDefaults(NewNode, NodeData);
+		return true;
+	}
+
+	if (Node->NodePosX != NodeData.PosX || Node->NodePosY != NodeData.PosY)
+	{
+		Node->Modify();
+		Node->NodePosX = NodeData.PosX;
+		Node->NodePosY = NodeData.PosY;
+		bOutModified = true;
+	}
+
+	if (ApplyPinDefaults(Node, NodeData))
+	{
+		bOutModified = true;
+	}
+
+	return true;
+}
+
+bool FBlueprintDeserializer::ApplyConnectionAdded(UBlueprint* Blueprint, const FNodeIndex& Nodes, const FBlueprintConnectionData& Connection, bool& bOutModified)
+{
+	UEdGraphNode* SourceNode = FindNodeById(Nodes, Connection.SourceNodeId);
+	UEdGraphNode* TargetNode = FindNodeById(Nodes, Connection.TargetNodeId);
+	if (!SourceNode || !TargetNode)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Connection references missing node (source=%s, target=%s)"),
+			*Connection.SourceNodeId, *Connection.TargetNodeId);
 		return false;
 	}
 
-	// Get or create the ubergraph
-	UEdGraph* EventGraph = nullptr;
-	if (Blueprint->UbergraphPages.Num() > 0)
+	if (!WireConnection(Connection, SourceNode, TargetNode))
 	{
-		EventGraph = Blueprint->UbergraphPages[0];
+		return false;
 	}
-	if (!EventGraph)
+
+	bOutModified = true;
+	return true;
+}
+
+bool FBlueprintDeserializer::ApplyConnectionRemoved(UBlueprint* Blueprint, const FString& ConnectionId, bool& bOutModified)
+{
+	FGuid ConnectionGuid;
+	if (!FGuid::Parse(ConnectionId, ConnectionGuid))
 	{
-		UE_LOG(LogTemp, Error, TEXT("BlueprintAIBridge: No event graph found in blueprint %s"), *Blueprint->GetName());
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Invalid connection ID '%s'"), *ConnectionId);
 		return false;
 	}
 
-	// Clear existing nodes (except the default event nodes we can't remove)
-	TArray<UEdGraphNode*> NodesToRemove;
-	for (UEdGraphNode* Node : EventGraph->Nodes)
+	// Backend-minted IDs were recorded when the link was wired; exported ones are derived from the pin GUIDs,
+	// so a miss indexes the live links once and looks again
+	if (!ConnectionPins.Contains(ConnectionGuid))
 	{
-		if (Node && Node->CanUserDeleteNode())
-		{
-			NodesToRemove.Add(Node);
-		}
+		IndexLiveConnections(Blueprint);
+	}
+
+	TPair<FEdGraphPinReference, FEdGraphPinReference> Pins;
+	UEdGraphPin* SourcePin = nullptr;
+	UEdGraphPin* TargetPin = nullptr;
+	if (ConnectionPins.RemoveAndCopyValue(ConnectionGuid, Pins))
+	{
+		SourcePin = Pins.Key.Get();
+		TargetPin = Pins.Value.Get();
 	}
-	for (UEdGraphNode* Node : NodesToRemove)
+	if (!SourcePin || !TargetPin || FBlueprintEditorUtils::FindBlueprintForNode(SourcePin->GetOwningNode()) != Blueprint)
 	{
-		EventGraph->RemoveNode(Node);
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: ConnectionRemoved target '%s' not found in %s"), *ConnectionId, *Blueprint->GetName());
+		return false;
 	}
 
-	// Clear the pin name map for this sync
-	PinNameMap.Empty();
+	if (SourcePin->LinkedTo.Contains(TargetPin))
+	{
+		SourcePin->BreakLinkTo(TargetPin);
+		bOutModified = true;
+	}
+	else
+	{
+		// Known link that someone already broke; the graph is in the requested state
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Connection '%s' was already unlinked"), *ConnectionId);
+	}
+	return true;
+}
 
-	// Create member variables from JSON (must happen before node creation so Get/Set nodes can resolve)
-	const TArray<TSharedPtr<FJsonValue>>* VariablesArray;
-	if (JsonState->TryGetArrayField(TEXT("variables"), VariablesArray))
+void FBlueprintDeserializer::IndexLiveConnections(UBlueprint* Blueprint)
+{
+	for (auto It = ConnectionPins.CreateIterator(); It; ++It)
 	{
-		CreateVariablesFromJson(Blueprint, *VariablesArray);
+		if (!It.Value().Key.Get() || !It.Value().Value.Get())
+		{
+			It.RemoveCurrent();
+		}
 	}
 
-	// Create nodes from JSON
-	TMap<FString, UEdGraphNode*> NodeMap;
-	const TArray<TSharedPtr<FJsonValue>>* NodesArray;
-	if (JsonState->TryGetArrayField(TEXT("nodes"), NodesArray))
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
 	{
-		for (const TSharedPtr<FJsonValue>& NodeVal : *NodesArray)
+		for (UEdGraphNode* Node : Graph->Nodes)
 		{
-			TSharedPtr<FJsonObject> NodeJson = NodeVal->AsObject();
-			if (!NodeJson.IsValid()) continue;
+			if (!Node) continue;
 
-			FString NodeId = NodeJson->GetStringField(TEXT("id"));
-			UEdGraphNode* NewNode = CreateNodeFromJson(Blueprint, EventGraph, NodeJson);
-			if (NewNode)
+			for (UEdGraphPin* Pin : Node->Pins)
 			{
-				NodeMap.Add(NodeId, NewNode);
+				if (Pin->Direction != EGPD_Output) continue;
+
+				const FGuid SourcePinGuid = FBlueprintIdRegistry::GetPinGuid(Pin);
+				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+				{
+					ConnectionPins.Add(FBlueprintIdRegistry::MakeConnectionGuid(SourcePinGuid, FBlueprintIdRegistry::GetPinGuid(LinkedPin)),
+						TPair<FEdGraphPinReference, FEdGraphPinReference>(FEdGraphPinReference(Pin), FEdGraphPinReference(LinkedPin)));
+				}
 			}
 		}
 	}
+}
+
+bool FBlueprintDeserializer::ApplyVariableAdded(UBlueprint* Blueprint, const FBlueprintVariableData& Variable, bool& bOutModified)
+{
+	if (FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, FName(*Variable.Name)) != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Variable '%s' already exists"), *Variable.Name);
+		return true;
+	}
 
-	// Wire connections
-	const TArray<TSharedPtr<FJsonValue>>* ConnectionsArray;
-	if (JsonState->TryGetArrayField(TEXT("connections"), ConnectionsArray))
+	// ApplyDelta regenerates the skeleton once the variable is in
+	Blueprint->Modify();
+	TSet<FName> TakenNames;
+	FBlueprintEditorUtils::GetClassVariableList(Blueprint, TakenNames);
+	if (!AddVariableFromData(Blueprint, Variable, TakenNames))
 	{
-		WireConnections(EventGraph, *ConnectionsArray, NodeMap, PinNameMap);
+		return false;
 	}
 
-	// Compile the blueprint
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	bOutModified = true;
+	return true;
+}
 
-	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Applied full sync to %s (%d nodes)"),
-		*Blueprint->GetName(), NodeMap.Num());
+bool FBlueprintDeserializer::ApplyVariableRemoved(UBlueprint* Blueprint, const FString& VariableId, bool& bOutModified)
+{
+	for (const FBPVariableDescription& VarDesc : Blueprint->NewVariables)
+	{
+		if (FBlueprintIdRegistry::MakeVariableId(VarDesc) == VariableId || VarDesc.VarName.ToString() == VariableId)
+		{
+			const FName VarName = VarDesc.VarName;
+			FBlueprintEditorUtils::RemoveMemberVariable(Blueprint, VarName);
+			bOutModified = true;
+			return true;
+		}
+	}
 
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: VariableRemoved target '%s' not found"), *VariableId);
 	return true;
 }
 
-UEdGraphNode* FBlueprintDeserializer::CreateNodeFromJson(UBlueprint* Blueprint, UEdGraph* Graph, const TSharedPtr<FJsonObject>& NodeJson)
+UEdGraph* FBlueprintDeserializer::GetEventGraph(UBlueprint* Blueprint) const
 {
-	FString NodeId = NodeJson->GetStringField(TEXT("id"));
-	FString Title = NodeJson->GetStringField(TEXT("title"));
-	FString Style = NodeJson->GetStringField(TEXT("style"));
-	int32 PosX = static_cast<int32>(NodeJson->GetNumberField(TEXT("positionX")));
-	int32 PosY = static_cast<int32>(NodeJson->GetNumberField(TEXT("positionY")));
+	UEdGraph* EventGraph = Blueprint->UbergraphPages.Num() > 0 ? Blueprint->UbergraphPages[0] : nullptr;
+	if (!EventGraph)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BlueprintAIBridge: No event graph found in blueprint %s"), *Blueprint->GetName());
+	}
+	return EventGraph;
+}
 
-	// Build PinNameMap from inputPins and outputPins arrays
-	TMap<FString, FString>& NodePinMap = PinNameMap.FindOrAdd(NodeId);
-	const TArray<TSharedPtr<FJsonValue>>* InputPinsArray;
-	if (NodeJson->TryGetArrayField(TEXT("inputPins"), InputPinsArray))
+void FBlueprintDeserializer::IndexNodes(UBlueprint* Blueprint, FNodeIndex& OutNodes)
+{
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
 	{
-		for (const TSharedPtr<FJsonValue>& PinVal : *InputPinsArray)
+		for (UEdGraphNode* Node : Graph->Nodes)
 		{
-			TSharedPtr<FJsonObject> PinJson = PinVal->AsObject();
-			if (!PinJson.IsValid()) continue;
-			FString PinId = PinJson->GetStringField(TEXT("id"));
-			FString PinName = PinJson->GetStringField(TEXT("name"));
-			NodePinMap.Add(PinId, PinName);
+			if (Node)
+			{
+				OutNodes.Add(FBlueprintIdRegistry::GetNodeGuid(Node), Node);
+			}
 		}
 	}
-	const TArray<TSharedPtr<FJsonValue>>* OutputPinsArray;
-	if (NodeJson->TryGetArrayField(TEXT("outputPins"), OutputPinsArray))
+}
+
+UEdGraphNode* FBlueprintDeserializer::FindNodeById(const FNodeIndex& Nodes, const FString& NodeId)
+{
+	FGuid NodeGuid;
+	if (!FGuid::Parse(NodeId, NodeGuid))
+	{
+		return nullptr;
+	}
+
+	const TWeakObjectPtr<UEdGraphNode>* Node = Nodes.Find(NodeGuid);
+	return Node ? Node->Get() : nullptr;
+}
+
+void FBlueprintDeserializer::AdoptIncomingIds(FNodeIndex& Nodes, UEdGraphNode* Node, const FBlueprintNodeData& NodeData)
+{
+	FGuid NodeGuid;
+	if (FGuid::Parse(NodeData.Id, NodeGuid) && !FindNodeById(Nodes, NodeData.Id))
+	{
+		Node->NodeGuid = NodeGuid;
+	}
+	Nodes.Add(FBlueprintIdRegistry::GetNodeGuid(Node), Node);
+
+	auto AdoptPins = [this, Node](const TArray<FBlueprintPinData>& Pins, EEdGraphPinDirection Direction)
+	{
+		for (const FBlueprintPinData& PinData : Pins)
+		{
+			FGuid PinGuid;
+			if (!FGuid::Parse(PinData.Id, PinGuid)) continue;
+
+			if (UEdGraphPin* Pin = FindPinByName(Node, PinData.Name, Direction))
+			{
+				Pin->PinId = PinGuid;
+			}
+		}
+	};
+
+	AdoptPins(NodeData.InputPins, EGPD_Input);
+	AdoptPins(NodeData.OutputPins, EGPD_Output);
+}
+
+bool FBlueprintDeserializer::ApplyPinDefaults(UEdGraphNode* Node, const FBlueprintNodeData& NodeData)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	bool bChanged = false;
+
+	for (const FBlueprintPinData& PinData : NodeData.InputPins)
 	{
-		for (const TSharedPtr<FJsonValue>& PinVal : *OutputPinsArray)
+		if (!PinData.bHasDefaultValue) continue;
+
+		UEdGraphPin* Pin = FindPinByName(Node, PinData.Name, EGPD_Input);
+		if (Pin && Pin->LinkedTo.Num() == 0 && Pin->DefaultValue != PinData.DefaultValue)
 		{
-			TSharedPtr<FJsonObject> PinJson = PinVal->AsObject();
-			if (!PinJson.IsValid()) continue;
-			FString PinId = PinJson->GetStringField(TEXT("id"));
-			FString PinName = PinJson->GetStringField(TEXT("name"));
-			NodePinMap.Add(PinId, PinName);
+			// Pins are serialized with their node, so the node's undo record covers the default
+			if (!bChanged)
+			{
+				Node->Modify();
+			}
+			Schema->TrySetDefaultValue(*Pin, PinData.DefaultValue);
+			bChanged = true;
 		}
 	}
 
+	return bChanged;
+}
+
+void FBlueprintDeserializer::RecordPinNames(const FBlueprintNodeData& NodeData)
+{
+	// Build PinNameMap from the input and output pins
+	TMap<FString, FString>& NodePinMap = PinNameMap.FindOrAdd(NodeData.Id);
+	for (const FBlueprintPinData& PinData : NodeData.InputPins)
+	{
+		NodePinMap.Add(PinData.Id, PinData.Name);
+	}
+	for (const FBlueprintPinData& PinData : NodeData.OutputPins)
+	{
+		NodePinMap.Add(PinData.Id, PinData.Name);
+	}
+}
+
+UEdGraphNode* FBlueprintDeserializer::CreateNodeFromData(UBlueprint* Blueprint, UEdGraph* Graph, FNodeIndex& Nodes, const FBlueprintNodeData& NodeData)
+{
+	const FString& Title = NodeData.Title;
+	const FString& Style = NodeData.Style;
+	const int32 PosX = NodeData.PosX;
+	const int32 PosY = NodeData.PosY;
+
+	RecordPinNames(NodeData);
+
 	// Create the appropriate node type based on style
 	UEdGraphNode* NewNode = nullptr;
 
@@ -148,7 +1139,7 @@ UEdGraphNode* FBlueprintDeserializer::CreateNodeFromJson(UBlueprint* Blueprint,
 	}
 	else if (Style == TEXT("Variable"))
 	{
-		NewNode = CreateVariableNode(Blueprint, Graph, Title, NodeJson, PosX, PosY);
+		NewNode = CreateVariableNode(Blueprint, Graph, Title, PosX, PosY);
 	}
 	else // "Function", "Macro", or anything else
 	{
@@ -157,6 +1148,7 @@ UEdGraphNode* FBlueprintDeserializer::CreateNodeFromJson(UBlueprint* Blueprint,
 
 	if (NewNode)
 	{
+		AdoptIncomingIds(Nodes, NewNode, NodeData);
 		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Created node '%s' (style=%s)"), *Title, *Style);
 	}
 	else
@@ -213,7 +1205,7 @@ UEdGraphNode* FBlueprintDeserializer::CreateEventNode(UBlueprint* Blueprint, UEd
 	// If still not found, try searching by display name
 	if (!EventFunc)
 	{
-		EventFunc = FindFunctionByDisplayName(EventName);
+		EventFunc = FindFunctionByDisplayName(EventName, Blueprint->ParentClass);
 	}
 
 	if (EventFunc)
@@ -248,7 +1240,8 @@ UEdGraphNode* FBlueprintDeserializer::CreateEventNode(UBlueprint* Blueprint, UEd
 
 UEdGraphNode* FBlueprintDeserializer::CreateFunctionNode(UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY)
 {
-	UFunction* Func = FindFunctionByDisplayName(Title);
+	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+	UFunction* Func = FindFunctionByDisplayName(Title, Blueprint ? Blueprint->ParentClass.Get() : nullptr);
 
 	UK2Node_CallFunction* FuncNode = NewObject<UK2Node_CallFunction>(Graph);
 	FuncNode->CreateNewGuid();
@@ -310,106 +1303,89 @@ UEdGraphNode* FBlueprintDeserializer::CreatePureNode(UEdGraph* Graph, const FStr
 	return CreateFunctionNode(Graph, Title, PosX, PosY);
 }
 
-bool FBlueprintDeserializer::WireConnections(UEdGraph* Graph,
-	const TArray<TSharedPtr<FJsonValue>>& Connections,
-	const TMap<FString, UEdGraphNode*>& NodeMap,
-	const TMap<FString, TMap<FString, FString>>& PinIdToNameMap)
+bool FBlueprintDeserializer::WireConnection(const FBlueprintConnectionData& Connection, UEdGraphNode* SourceNode, UEdGraphNode* TargetNode)
 {
-	int32 WiredCount = 0;
-	int32 FailedCount = 0;
-
-	for (const TSharedPtr<FJsonValue>& ConnVal : Connections)
+	UEdGraphPin* SourcePin = nullptr;
+	UEdGraphPin* TargetPin = nullptr;
+	if (!ResolveConnectionPins(Connection, SourceNode, TargetNode, SourcePin, TargetPin))
 	{
-		TSharedPtr<FJsonObject> ConnJson = ConnVal->AsObject();
-		if (!ConnJson.IsValid()) continue;
-
-		FString SourceNodeId = ConnJson->GetStringField(TEXT("sourceNodeId"));
-		FString TargetNodeId = ConnJson->GetStringField(TEXT("targetNodeId"));
-		FString SourcePinId = ConnJson->GetStringField(TEXT("sourcePinId"));
-		FString TargetPinId = ConnJson->GetStringField(TEXT("targetPinId"));
-		FString PinType = ConnJson->GetStringField(TEXT("pinType"));
-
-		UEdGraphNode* const* SourceNodePtr = NodeMap.Find(SourceNodeId);
-		UEdGraphNode* const* TargetNodePtr = NodeMap.Find(TargetNodeId);
-
-		if (!SourceNodePtr || !TargetNodePtr)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Connection references missing node (source=%s, target=%s)"),
-				*SourceNodeId, *TargetNodeId);
-			FailedCount++;
-			continue;
-		}
+		return false;
+	}
 
-		// Resolve pin names from the PinIdToNameMap
-		FString SourcePinName;
-		FString TargetPinName;
+	if (!SourcePin->LinkedTo.Contains(TargetPin))
+	{
+		SourcePin->MakeLinkTo(TargetPin);
+	}
+	RecordConnection(Connection.Id, SourcePin, TargetPin);
+	return true;
+}
 
-		const TMap<FString, FString>* SourcePinMap = PinIdToNameMap.Find(SourceNodeId);
-		if (SourcePinMap)
-		{
-			const FString* Name = SourcePinMap->Find(SourcePinId);
-			if (Name) SourcePinName = *Name;
-		}
+void FBlueprintDeserializer::RecordConnection(const FString& ConnectionId, UEdGraphPin* SourcePin, UEdGraphPin* TargetPin)
+{
+	FGuid ConnectionGuid;
+	if (FGuid::Parse(ConnectionId, ConnectionGuid))
+	{
+		ConnectionPins.Add(ConnectionGuid, TPair<FEdGraphPinReference, FEdGraphPinReference>(FEdGraphPinReference(SourcePin), FEdGraphPinReference(TargetPin)));
+	}
+}
 
-		const TMap<FString, FString>* TargetPinMap = PinIdToNameMap.Find(TargetNodeId);
-		if (TargetPinMap)
-		{
-			const FString* Name = TargetPinMap->Find(TargetPinId);
-			if (Name) TargetPinName = *Name;
-		}
+bool FBlueprintDeserializer::ResolveConnectionPins(const FBlueprintConnectionData& Connection, UEdGraphNode* SourceNode, UEdGraphNode* TargetNode,
+	UEdGraphPin*& OutSourcePin, UEdGraphPin*& OutTargetPin)
+{
+	OutSourcePin = ResolvePin(SourceNode, Connection.SourceNodeId, Connection.SourcePinId, Connection.PinType, EGPD_Output);
+	OutTargetPin = ResolvePin(TargetNode, Connection.TargetNodeId, Connection.TargetPinId, Connection.PinType, EGPD_Input);
 
-		UEdGraphPin* SourcePin = nullptr;
-		UEdGraphPin* TargetPin = nullptr;
+	if (OutSourcePin && OutTargetPin)
+	{
+		return true;
+	}
 
-		// Try to find pins by resolved display name
-		if (!SourcePinName.IsEmpty())
-		{
-			SourcePin = FindPinByName(*SourceNodePtr, SourcePinName, EGPD_Output);
-		}
-		if (!TargetPinName.IsEmpty())
-		{
-			TargetPin = FindPinByName(*TargetNodePtr, TargetPinName, EGPD_Input);
-		}
+	UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Failed to wire connection (srcNode=%s, srcPin=%s, tgtNode=%s, tgtPin=%s)"),
+		*Connection.SourceNodeId, *Connection.SourcePinId, *Connection.TargetNodeId, *Connection.TargetPinId);
+	return false;
+}
 
-		// Fallback for exec pins: if pin name is empty or not found, try matching by exec type
-		if (!SourcePin && PinType == TEXT("Exec"))
+UEdGraphPin* FBlueprintDeserializer::ResolvePin(UEdGraphNode* Node, const FString& NodeId, const FString& PinId,
+	const FString& PinType, EEdGraphPinDirection Direction)
+{
+	// Exported (or adopted) IDs are the pin GUIDs themselves
+	FGuid PinGuid;
+	if (FGuid::Parse(PinId, PinGuid))
+	{
+		for (UEdGraphPin* Pin : Node->Pins)
 		{
-			for (UEdGraphPin* Pin : (*SourceNodePtr)->Pins)
+			if (Pin->Direction == Direction && Pin->PinId == PinGuid)
 			{
-				if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-				{
-					SourcePin = Pin;
-					break;
-				}
+				return Pin;
 			}
 		}
-		if (!TargetPin && PinType == TEXT("Exec"))
+	}
+
+	// Otherwise resolve the pin name recorded when the node was created
+	if (const TMap<FString, FString>* NodePinMap = PinNameMap.Find(NodeId))
+	{
+		if (const FString* PinName = NodePinMap->Find(PinId))
 		{
-			for (UEdGraphPin* Pin : (*TargetNodePtr)->Pins)
+			if (UEdGraphPin* Pin = FindPinByName(Node, *PinName, Direction))
 			{
-				if (Pin->Direction == EGPD_Input && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-				{
-					TargetPin = Pin;
-					break;
-				}
+				return Pin;
 			}
 		}
+	}
 
-		if (SourcePin && TargetPin)
-		{
-			SourcePin->MakeLinkTo(TargetPin);
-			WiredCount++;
-		}
-		else
+	// Fallback for exec pins: if pin name is empty or not found, try matching by exec type
+	if (PinType == TEXT("Exec"))
+	{
+		for (UEdGraphPin* Pin : Node->Pins)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Failed to wire connection (srcNode=%s, srcPin=%s [%s], tgtNode=%s, tgtPin=%s [%s])"),
-				*SourceNodeId, *SourcePinId, *SourcePinName, *TargetNodeId, *TargetPinId, *TargetPinName);
-			FailedCount++;
+			if (Pin->Direction == Direction && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+			{
+				return Pin;
+			}
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Wired %d connections (%d failed)"), WiredCount, FailedCount);
-	return WiredCount > 0;
+	return nullptr;
 }
 
 UEdGraphPin* FBlueprintDeserializer::FindPinByName(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction)
@@ -437,34 +1413,19 @@ UEdGraphPin* FBlueprintDeserializer::FindPinByName(UEdGraphNode* Node, const FSt
 	return nullptr;
 }
 
-UFunction* FBlueprintDeserializer::FindFunctionByDisplayName(const FString& DisplayName)
+UFunction* FBlueprintDeserializer::FindFunctionByDisplayName(const FString& DisplayName, const UClass* ContextClass)
 {
-	// Check cache first
-	if (UFunction** CachedFunc = FunctionCache.Find(DisplayName))
+	UFunction* Func = FBlueprintFunctionIndex::Get().Find(DisplayName, ContextClass);
+	if (Func)
 	{
-		return *CachedFunc;
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Resolved function '%s' → %s::%s"),
+			*DisplayName, *Func->GetOuterUClass()->GetName(), *Func->GetName());
 	}
-
-	// Search across all loaded classes
-	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	else
 	{
-		UClass* Class = *ClassIt;
-		for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
-		{
-			UFunction* Func = *FuncIt;
-			if (Func->GetDisplayNameText().ToString() == DisplayName)
-			{
-				FunctionCache.Add(DisplayName, Func);
-				UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Resolved function '%s' → %s::%s"),
-					*DisplayName, *Class->GetName(), *Func->GetName());
-				return Func;
-			}
-		}
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Could not find UFunction with display name '%s'"), *DisplayName);
 	}
-
-	UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Could not find UFunction with display name '%s'"), *DisplayName);
-	FunctionCache.Add(DisplayName, nullptr);
-	return nullptr;
+	return Func;
 }
 
 FEdGraphPinType FBlueprintDeserializer::MapPinTypeFromString(const FString& TypeStr)
@@ -523,64 +1484,205 @@ FEdGraphPinType FBlueprintDeserializer::MapPinTypeFromString(const FString& Type
 	return PinType;
 }
 
-void FBlueprintDeserializer::CreateVariablesFromJson(UBlueprint* Blueprint, const TArray<TSharedPtr<FJsonValue>>& VariablesArray)
+FBlueprintDeserializer::FVariableSyncResult FBlueprintDeserializer::SyncVariables(UBlueprint* Blueprint,
+	const TArray<FBlueprintVariableData>& Variables)
 {
-	// Clear existing user-defined variables (NewVariables), preserving system variables
-	Blueprint->NewVariables.Empty();
+	const double StartTime = FPlatformTime::Seconds();
+	FVariableSyncResult Result;
+
+	// Live variables by ID and by name; names are what the editor utilities take, and they stay valid until renamed
+	TMap<FString, FName> LiveById;
+	TSet<FName> LiveNames;
+	LiveById.Reserve(Blueprint->NewVariables.Num());
+	for (const FBPVariableDescription& VarDesc : Blueprint->NewVariables)
+	{
+		LiveById.Add(FBlueprintIdRegistry::MakeVariableId(VarDesc), VarDesc.VarName);
+		LiveNames.Add(VarDesc.VarName);
+	}
+
+	// Pair each incoming variable with a live one: stable ID first, then name
+	TArray<TPair<const FBlueprintVariableData*, FName>> Matched;
+	TArray<const FBlueprintVariableData*> ToAdd;
+	TSet<FName> Claimed;
+	for (const FBlueprintVariableData& Variable : Variables)
+	{
+		const FName* ById = LiveById.Find(Variable.Id);
+		const FName ByName(*Variable.Name);
+		if (ById && !Claimed.Contains(*ById))
+		{
+			Matched.Emplace(&Variable, *ById);
+			Claimed.Add(*ById);
+		}
+		else if (LiveNames.Contains(ByName) && !Claimed.Contains(ByName))
+		{
+			Matched.Emplace(&Variable, ByName);
+			Claimed.Add(ByName);
+		}
+		else
+		{
+			ToAdd.Add(&Variable);
+		}
+	}
 
-	for (const TSharedPtr<FJsonValue>& VarVal : VariablesArray)
+	// Remove first, so a name it frees can be reused by a rename or an addition
+	TArray<FName> ToRemove;
+	for (const FName& Name : LiveNames)
 	{
-		TSharedPtr<FJsonObject> VarJson = VarVal->AsObject();
-		if (!VarJson.IsValid()) continue;
+		if (!Claimed.Contains(Name))
+		{
+			ToRemove.Add(Name);
+		}
+	}
+	if (ToRemove.Num() > 0)
+	{
+		FBlueprintEditorUtils::RemoveMemberVariables(Blueprint, ToRemove);
+		Result.Removed = ToRemove.Num();
+	}
 
-		FString Name = VarJson->GetStringField(TEXT("name"));
-		FString TypeStr = VarJson->GetStringField(TEXT("type"));
+	bool bModifyCalled = false;
+	for (const TPair<const FBlueprintVariableData*, FName>& Pair : Matched)
+	{
+		const FBlueprintVariableData& Variable = *Pair.Key;
+		FName Name = Pair.Value;
 
-		FEdGraphPinType PinType = MapPinTypeFromString(TypeStr);
+		// The editor utilities fix up every node referencing the variable, in all graphs
+		const FName NewName(*Variable.Name);
+		if (Name != NewName)
+		{
+			if (FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, NewName) != INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Can't rename variable '%s' to '%s', the name is taken"),
+					*Name.ToString(), *Variable.Name);
+			}
+			else
+			{
+				FBlueprintEditorUtils::RenameMemberVariable(Blueprint, Name, NewName);
+				Name = NewName;
+				Result.Renamed++;
+			}
+		}
 
-		// Add the member variable
-		bool bSuccess = FBlueprintEditorUtils::AddMemberVariable(Blueprint, FName(*Name), PinType);
-		if (!bSuccess)
+		int32 Index = FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Name);
+		if (Index == INDEX_NONE)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Failed to add variable '%s'"), *Name);
 			continue;
 		}
+		if (FBlueprintSerializer::MapPinTypeFromPinType(Blueprint->NewVariables[Index].VarType) != Variable.Type)
+		{
+			FBlueprintEditorUtils::ChangeMemberVariableType(Blueprint, Name, MapPinTypeFromString(Variable.Type));
+			Result.Retyped++;
+			Index = FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Name);
+		}
 
-		// Find the newly created variable description and set properties
-		for (FBPVariableDescription& VarDesc : Blueprint->NewVariables)
+		// Metadata changes are made in place; none of them moves the class layout
+		FBPVariableDescription& VarDesc = Blueprint->NewVariables[Index];
+		const bool bDefaultChanged = VarDesc.DefaultValue != Variable.DefaultValue;
+		const bool bCategoryChanged = !Variable.Category.IsEmpty() && !VarDesc.Category.EqualTo(FText::FromString(Variable.Category));
+		const uint64 PropertyFlags = ApplyEditableFlags(VarDesc.PropertyFlags, Variable.bIsEditable);
+		const bool bFlagsChanged = PropertyFlags != VarDesc.PropertyFlags;
+		if (!bDefaultChanged && !bCategoryChanged && !bFlagsChanged)
 		{
-			if (VarDesc.VarName == FName(*Name))
-			{
-				// Set default value
-				FString DefaultValue;
-				if (VarJson->TryGetStringField(TEXT("defaultValue"), DefaultValue) && !DefaultValue.IsEmpty())
-				{
-					VarDesc.DefaultValue = DefaultValue;
-				}
+			continue;
+		}
 
-				// Set category
-				FString Category;
-				if (VarJson->TryGetStringField(TEXT("category"), Category) && !Category.IsEmpty())
-				{
-					VarDesc.Category = FText::FromString(Category);
-				}
+		if (!bModifyCalled)
+		{
+			Blueprint->Modify();
+			bModifyCalled = true;
+		}
+		if (bDefaultChanged)
+		{
+			VarDesc.DefaultValue = Variable.DefaultValue;
+		}
+		if (bCategoryChanged)
+		{
+			VarDesc.Category = FText::FromString(Variable.Category);
+		}
+		if (bFlagsChanged)
+		{
+			VarDesc.PropertyFlags = PropertyFlags;
+		}
+		Result.Updated++;
+	}
 
-				// Set editability flags
-				bool bIsEditable = false;
-				if (VarJson->TryGetBoolField(TEXT("isEditable"), bIsEditable) && bIsEditable)
-				{
-					VarDesc.PropertyFlags |= CPF_Edit | CPF_BlueprintVisible;
-				}
+	if (ToAdd.Num() > 0)
+	{
+		if (!bModifyCalled)
+		{
+			Blueprint->Modify();
+		}
 
-				break;
-			}
+		// Names inherited from the parent class stay taken; the list is built once rather than per variable
+		TSet<FName> TakenNames;
+		FBlueprintEditorUtils::GetClassVariableList(Blueprint, TakenNames);
+		for (const FBlueprintVariableData* Variable : ToAdd)
+		{
+			Result.Added += AddVariableFromData(Blueprint, *Variable, TakenNames) ? 1 : 0;
 		}
 
-		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Created variable '%s' (type=%s)"), *Name, *TypeStr);
+		// The skeleton is left stale here: the caller marks the blueprint structurally modified once it is done,
+		// and a Get/Set node for one of these variables rebuilds it first through EnsureSkeletonVariable
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Synced %d variables on %s (%d added, %d removed, %d renamed, %d retyped, %d updated) in %.2f ms"),
+		Variables.Num(), *Blueprint->GetName(), Result.Added, Result.Removed, Result.Renamed, Result.Retyped, Result.Updated,
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return Result;
+}
+
+bool FBlueprintDeserializer::AddVariableFromData(UBlueprint* Blueprint, const FBlueprintVariableData& Variable, TSet<FName>& TakenNames)
+{
+	const FName Name(*Variable.Name);
+	if (Name == NAME_None || TakenNames.Contains(Name))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Failed to add variable '%s'"), *Variable.Name);
+		return false;
+	}
+
+	// Same defaults FBlueprintEditorUtils::AddMemberVariable gives a new variable, minus its per-call skeleton regeneration
+	FBPVariableDescription VarDesc;
+	VarDesc.VarName = Name;
+	VarDesc.VarType = MapPinTypeFromString(Variable.Type);
+	VarDesc.VarType.bIsConst = false;
+	VarDesc.VarType.bIsWeakPointer = false;
+	VarDesc.VarType.bIsReference = false;
+	VarDesc.FriendlyName = FName::NameToDisplayString(Variable.Name, VarDesc.VarType.PinCategory == UEdGraphSchema_K2::PC_Boolean);
+	VarDesc.PropertyFlags = ApplyEditableFlags(VarDesc.PropertyFlags, Variable.bIsEditable);
+	VarDesc.ReplicationCondition = COND_None;
+	VarDesc.Category = UEdGraphSchema_K2::VR_DefaultCategory;
+
+	// Keep the backend's variable ID so exports round-trip it
+	FGuid VarGuid;
+	VarDesc.VarGuid = FGuid::Parse(Variable.Id, VarGuid) ? VarGuid : FGuid::NewGuid();
+
+	// Set default value
+	if (!Variable.DefaultValue.IsEmpty())
+	{
+		VarDesc.DefaultValue = Variable.DefaultValue;
+	}
+
+	// Set category
+	if (!Variable.Category.IsEmpty())
+	{
+		VarDesc.Category = FText::FromString(Variable.Category);
 	}
+
+	Blueprint->NewVariables.Add(MoveTemp(VarDesc));
+	FBlueprintEditorUtils::ValidateBlueprintChildVariables(Blueprint, Name);
+	TakenNames.Add(Name);
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Created variable '%s' (type=%s)"), *Variable.Name, *Variable.Type);
+	return true;
+}
+
+uint64 FBlueprintDeserializer::ApplyEditableFlags(uint64 PropertyFlags, bool bIsEditable)
+{
+	// Every member variable stays editable in the class defaults; isEditable decides whether instances can edit it too
+	PropertyFlags |= CPF_Edit | CPF_BlueprintVisible;
+	return bIsEditable ? PropertyFlags & ~uint64(CPF_DisableEditOnInstance) : PropertyFlags | CPF_DisableEditOnInstance;
 }
 
-UEdGraphNode* FBlueprintDeserializer::CreateVariableNode(UBlueprint* Blueprint, UEdGraph* Graph, const FString& Title, const TSharedPtr<FJsonObject>& NodeJson, int32 PosX, int32 PosY)
+UEdGraphNode* FBlueprintDeserializer::CreateVariableNode(UBlueprint* Blueprint, UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY)
 {
 	// Determine if this is a Get or Set node, and extract the variable name
 	bool bIsSetter = false;
@@ -596,8 +1698,7 @@ UEdGraphNode* FBlueprintDeserializer::CreateVariableNode(UBlueprint* Blueprint,
 		VarName = Title.RightChop(4);
 	}
 
-	// Ensure the skeleton class is up to date so we can find the property
-	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	EnsureSkeletonVariable(Blueprint, FName(*VarName));
 
 	if (bIsSetter)
 	{
@@ -624,3 +1725,20 @@ UEdGraphNode* FBlueprintDeserializer::CreateVariableNode(UBlueprint* Blueprint,
 		return GetNode;
 	}
 }
+
+void FBlueprintDeserializer::EnsureSkeletonVariable(UBlueprint* Blueprint, FName VarName)
+{
+	if (Blueprint->SkeletonGeneratedClass && FindFProperty<FProperty>(Blueprint->SkeletonGeneratedClass, VarName))
+	{
+		return;
+	}
+
+	// A variable added since the skeleton was last built; one regeneration covers every node after it, and
+	// a name that is still missing afterwards is not worth another. Only the skeleton is rebuilt: marking the
+	// blueprint structurally modified is left to the end of the apply, so it happens once
+	if (!RefreshedSkeletons.Contains(Blueprint))
+	{
+		FKismetEditorUtilities::GenerateBlueprintSkeleton(Blueprint, true);
+		RefreshedSkeletons.Add(Blueprint);
+	}
+}
@@ -0,0 +1,87 @@
+#include "BlueprintExportCache.h"
+
+FBlueprintExportCache::FBlueprintExportCache(int64 InMaxBytes)
+	: MaxBytes(InMaxBytes)
+{
+}
+
+bool FBlueprintExportCache::Find(const FString& Path, EBlueprintWireFormat Format, uint64 Revision, TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>& OutBody)
+{
+	const FKey Key(Path, Format);
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry || Entry->Revision != Revision)
+	{
+		if (Entry)
+		{
+			// Stale revision; the blueprint changed without the invalidation reaching us
+			Remove(Key);
+		}
+		Misses++;
+		return false;
+	}
+
+	Entry->LastUsed = ++UseCounter;
+	OutBody = Entry->Body;
+	Hits++;
+	return true;
+}
+
+void FBlueprintExportCache::Add(const FString& Path, EBlueprintWireFormat Format, uint64 Revision, const FBody& Body)
+{
+	// Bodies that would take over most of the budget aren't worth holding
+	if (Body->Num() > MaxBytes / 4)
+	{
+		return;
+	}
+
+	const FKey Key(Path, Format);
+	Remove(Key);
+
+	while (TotalBytes + Body->Num() > MaxBytes && Entries.Num() > 0)
+	{
+		const FKey* Oldest = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const auto& Pair : Entries)
+		{
+			if (Pair.Value.LastUsed < OldestUse)
+			{
+				OldestUse = Pair.Value.LastUsed;
+				Oldest = &Pair.Key;
+			}
+		}
+		Remove(FKey(*Oldest));
+		Evictions++;
+	}
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Revision = Revision;
+	Entry.LastUsed = ++UseCounter;
+	Entry.Body = Body;
+	TotalBytes += Body->Num();
+}
+
+void FBlueprintExportCache::Invalidate(const FString& Path)
+{
+	Remove(FKey(Path, EBlueprintWireFormat::Json));
+	Remove(FKey(Path, EBlueprintWireFormat::CompactBinary));
+}
+
+FBlueprintExportCache::FStats FBlueprintExportCache::GetStats() const
+{
+	FStats Stats;
+	Stats.Hits = Hits;
+	Stats.Misses = Misses;
+	Stats.Evictions = Evictions;
+	Stats.Bytes = TotalBytes;
+	Stats.Entries = Entries.Num();
+	return Stats;
+}
+
+void FBlueprintExportCache::Remove(const FKey& Key)
+{
+	FEntry Removed;
+	if (Entries.RemoveAndCopyValue(Key, Removed))
+	{
+		TotalBytes -= Removed.Body->Num();
+	}
+}
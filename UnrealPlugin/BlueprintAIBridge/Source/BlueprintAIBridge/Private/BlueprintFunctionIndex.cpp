@@ -0,0 +1,265 @@
+#include "BlueprintFunctionIndex.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/Package.h"
+
+FBlueprintFunctionIndex& FBlueprintFunctionIndex::Get()
+{
+	static FBlueprintFunctionIndex Instance;
+	return Instance;
+}
+
+void FBlueprintFunctionIndex::Startup()
+{
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FBlueprintFunctionIndex::OnModulesChanged);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FBlueprintFunctionIndex::OnReloadComplete);
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FBlueprintFunctionIndex::OnAssetLoaded);
+	if (GEditor)
+	{
+		PreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FBlueprintFunctionIndex::OnBlueprintPreCompile);
+		CompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FBlueprintFunctionIndex::OnBlueprintCompiled);
+	}
+
+	StartRebuild();
+}
+
+void FBlueprintFunctionIndex::Shutdown()
+{
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(PreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(CompiledHandle);
+	}
+	CompilingBlueprints.Empty();
+
+	if (BuildTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(BuildTickHandle);
+		BuildTickHandle.Reset();
+	}
+
+	PendingClasses.Empty();
+	BuildCursor = 0;
+	ByDisplayName.Empty();
+	ByInternalName.Empty();
+}
+
+UFunction* FBlueprintFunctionIndex::Find(const FString& Name, const UClass* ContextClass)
+{
+	// A lookup that arrives before the sliced build is done finishes it here; still cheaper than a scan per miss
+	if (BuildCursor < PendingClasses.Num())
+	{
+		StepBuild(TNumericLimits<double>::Max());
+	}
+
+	if (UFunction* Func = FindIndexed(Name, ContextClass))
+	{
+		return Func;
+	}
+
+	// A blueprint class the load and compile notifications missed (e.g. created in this session and not compiled
+	// since); only blueprint classes can be missing, so only they are scanned
+	IndexBlueprintClasses();
+	return FindIndexed(Name, ContextClass);
+}
+
+UFunction* FBlueprintFunctionIndex::FindIndexed(const FString& Name, const UClass* ContextClass) const
+{
+	if (const FFunctionList* Candidates = ByDisplayName.Find(Name))
+	{
+		if (UFunction* Func = PickBest(*Candidates, ContextClass))
+		{
+			return Func;
+		}
+	}
+
+	if (const FFunctionList* Candidates = ByInternalName.Find(Name))
+	{
+		return PickBest(*Candidates, ContextClass);
+	}
+
+	return nullptr;
+}
+
+void FBlueprintFunctionIndex::StartRebuild()
+{
+	ByDisplayName.Empty(ByDisplayName.Num());
+	ByInternalName.Empty(ByInternalName.Num());
+
+	// Collecting the class pointers is quick; reading their functions' metadata is what gets sliced
+	PendingClasses.Reset();
+	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	{
+		PendingClasses.Add(*ClassIt);
+	}
+	BuildCursor = 0;
+	BuildStartTime = FPlatformTime::Seconds();
+
+	if (!BuildTickHandle.IsValid())
+	{
+		BuildTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBlueprintFunctionIndex::TickBuild), 0.0f);
+	}
+}
+
+bool FBlueprintFunctionIndex::StepBuild(double BudgetSeconds)
+{
+	const double Deadline = BudgetSeconds >= TNumericLimits<double>::Max() ? BudgetSeconds : FPlatformTime::Seconds() + BudgetSeconds;
+	while (BuildCursor < PendingClasses.Num())
+	{
+		IndexClass(PendingClasses[BuildCursor++].Get());
+
+		// Checking the clock every class would cost more than most classes take to index
+		if ((BuildCursor & 63) == 0 && FPlatformTime::Seconds() >= Deadline)
+		{
+			return false;
+		}
+	}
+
+	if (PendingClasses.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Indexed %d function names from %d classes, %.1f ms after starting"),
+			ByDisplayName.Num(), PendingClasses.Num(), (FPlatformTime::Seconds() - BuildStartTime) * 1000.0);
+		PendingClasses.Empty();
+		BuildCursor = 0;
+	}
+	return true;
+}
+
+bool FBlueprintFunctionIndex::TickBuild(float DeltaTime)
+{
+	if (StepBuild(SliceBudgetSeconds))
+	{
+		BuildTickHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FBlueprintFunctionIndex::IndexClass(UClass* Class)
+{
+	if (!Class || Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+	{
+		return;
+	}
+
+	for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+	{
+		UFunction* Func = *FuncIt;
+		ByDisplayName.FindOrAdd(Func->GetDisplayNameText().ToString()).AddUnique(Func);
+		ByInternalName.FindOrAdd(Func->GetName()).AddUnique(Func);
+	}
+}
+
+void FBlueprintFunctionIndex::IndexModule(FName ModuleName)
+{
+	UPackage* Package = FindPackage(nullptr, *(TEXT("/Script/") + ModuleName.ToString()));
+	if (!Package)
+	{
+		return;
+	}
+
+	// Indexed straight away, whether or not the sliced build has reached these classes; AddUnique keeps
+	// the build from listing them twice if it gets there later
+	TArray<UObject*> Objects;
+	GetObjectsWithPackage(Package, Objects, false);
+	for (UObject* Object : Objects)
+	{
+		IndexClass(Cast<UClass>(Object));
+	}
+}
+
+void FBlueprintFunctionIndex::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason == EModuleChangeReason::ModuleLoaded)
+	{
+		IndexModule(ModuleName);
+	}
+}
+
+void FBlueprintFunctionIndex::OnReloadComplete(EReloadCompleteReason Reason)
+{
+	// Hot reload and Live Coding replace class objects; reindex everything over the next frames
+	StartRebuild();
+}
+
+void FBlueprintFunctionIndex::OnAssetLoaded(UObject* Asset)
+{
+	if (const UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		IndexClass(Blueprint->GeneratedClass);
+	}
+	else if (UBlueprintGeneratedClass* Class = Cast<UBlueprintGeneratedClass>(Asset))
+	{
+		IndexClass(Class);
+	}
+}
+
+void FBlueprintFunctionIndex::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	CompilingBlueprints.AddUnique(Blueprint);
+}
+
+void FBlueprintFunctionIndex::OnBlueprintCompiled()
+{
+	// Compiling regenerates the class's functions, so the new ones are indexed once the whole batch is done
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : CompilingBlueprints)
+	{
+		if (Blueprint.IsValid())
+		{
+			IndexClass(Blueprint->GeneratedClass);
+		}
+	}
+	CompilingBlueprints.Reset();
+}
+
+void FBlueprintFunctionIndex::IndexBlueprintClasses()
+{
+	for (TObjectIterator<UBlueprintGeneratedClass> ClassIt; ClassIt; ++ClassIt)
+	{
+		IndexClass(*ClassIt);
+	}
+}
+
+UFunction* FBlueprintFunctionIndex::PickBest(const FFunctionList& Candidates, const UClass* ContextClass)
+{
+	UFunction* Best = nullptr;
+	int32 BestScore = -1;
+
+	for (const TWeakObjectPtr<UFunction>& Candidate : Candidates)
+	{
+		// Functions a recompile replaced are moved out of their class before they are collected
+		UFunction* Func = Candidate.Get();
+		if (!Func || !Func->GetOuterUClass())
+		{
+			continue;
+		}
+
+		int32 Score = 0;
+		if (ContextClass && ContextClass->IsChildOf(Func->GetOuterUClass()))
+		{
+			Score += 4;
+		}
+		if (Func->HasAnyFunctionFlags(FUNC_BlueprintCallable | FUNC_BlueprintPure | FUNC_BlueprintEvent))
+		{
+			Score += 2;
+		}
+		if (!Func->GetOuterUClass()->HasAnyClassFlags(CLASS_Deprecated))
+		{
+			Score += 1;
+		}
+
+		if (Score > BestScore)
+		{
+			Best = Func;
+			BestScore = Score;
+		}
+	}
+
+	return Best;
+}
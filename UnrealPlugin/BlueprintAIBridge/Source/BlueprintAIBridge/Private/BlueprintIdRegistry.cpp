@@ -0,0 +1,94 @@
+#include "BlueprintIdRegistry.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Engine/Blueprint.h"
+#include "Hash/CityHash.h"
+
+FGuid FBlueprintIdRegistry::GetNodeGuid(const UEdGraphNode* Node)
+{
+	if (Node->NodeGuid.IsValid())
+	{
+		return Node->NodeGuid;
+	}
+
+	// Legacy nodes can lack a GUID; derive one from the object path so it is still stable
+	return FGuid::NewDeterministicGuid(Node->GetPathName());
+}
+
+FGuid FBlueprintIdRegistry::GetPinGuid(const UEdGraphPin* Pin)
+{
+	if (Pin->PinId.IsValid())
+	{
+		return Pin->PinId;
+	}
+
+	const FGuid NodeGuid = GetNodeGuid(Pin->GetOwningNode());
+	return FGuid::NewDeterministicGuid(Pin->PinName.ToString(), GetTypeHash(NodeGuid) | (uint64(Pin->Direction) << 32));
+}
+
+FGuid FBlueprintIdRegistry::MakeConnectionGuid(const FGuid& SourcePinGuid, const FGuid& TargetPinGuid)
+{
+	const FGuid Endpoints[2] = { SourcePinGuid, TargetPinGuid };
+	const char* Bytes = reinterpret_cast<const char*>(Endpoints);
+
+	const uint64 Low = CityHash64(Bytes, sizeof(Endpoints));
+	const uint64 High = CityHash64WithSeed(Bytes, sizeof(Endpoints), Low);
+
+	return FGuid(uint32(High >> 32), uint32(High), uint32(Low >> 32), uint32(Low));
+}
+
+FString FBlueprintIdRegistry::MakeNodeId(const UEdGraphNode* Node)
+{
+	return GetNodeGuid(Node).ToString(EGuidFormats::DigitsWithHyphensLower);
+}
+
+FString FBlueprintIdRegistry::MakePinId(const UEdGraphPin* Pin)
+{
+	return GetPinGuid(Pin).ToString(EGuidFormats::DigitsWithHyphensLower);
+}
+
+FString FBlueprintIdRegistry::MakeConnectionId(const UEdGraphPin* SourcePin, const UEdGraphPin* TargetPin)
+{
+	return MakeConnectionGuid(GetPinGuid(SourcePin), GetPinGuid(TargetPin)).ToString(EGuidFormats::DigitsWithHyphensLower);
+}
+
+FString FBlueprintIdRegistry::MakeVariableId(const FBPVariableDescription& VarDesc)
+{
+	if (VarDesc.VarGuid.IsValid())
+	{
+		return VarDesc.VarGuid.ToString(EGuidFormats::DigitsWithHyphensLower);
+	}
+	return FGuid::NewDeterministicGuid(VarDesc.VarName.ToString()).ToString(EGuidFormats::DigitsWithHyphensLower);
+}
+
+void FBlueprintIdRegistry::Reset(int32 ExpectedNodes, int32 ExpectedPins)
+{
+	NodesById.Empty(ExpectedNodes);
+	IdsByNode.Empty(ExpectedNodes);
+	PinsById.Empty(ExpectedPins);
+	IdsByPin.Empty(ExpectedPins);
+}
+
+void FBlueprintIdRegistry::RegisterNode(const FString& Id, UEdGraphNode* Node)
+{
+	NodesById.Add(Id, Node);
+	IdsByNode.Add(Node, Id);
+}
+
+void FBlueprintIdRegistry::RegisterPin(const FString& Id, UEdGraphPin* Pin)
+{
+	PinsById.Add(Id, Pin);
+	IdsByPin.Add(Pin, Id);
+}
+
+UEdGraphNode* FBlueprintIdRegistry::FindNode(const FString& Id) const
+{
+	UEdGraphNode* const* Found = NodesById.Find(Id);
+	return Found ? *Found : nullptr;
+}
+
+UEdGraphPin* FBlueprintIdRegistry::FindPin(const FString& Id) const
+{
+	UEdGraphPin* const* Found = PinsById.Find(Id);
+	return Found ? *Found : nullptr;
+}
@@ -0,0 +1,336 @@
+#include "BlueprintJsonReader.h"
+
+FBlueprintJsonReader::FBlueprintJsonReader(TConstArrayView<uint8> Utf8Body)
+	: Reader(TJsonReaderFactory<UTF8CHAR>::CreateFromView(
+		FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8Body.GetData()), Utf8Body.Num())))
+{
+}
+
+template <typename FieldFuncType>
+bool FBlueprintJsonReader::ReadObject(FieldFuncType&& OnField)
+{
+	EJsonNotation Notation;
+	while (Reader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+		if (Notation == EJsonNotation::Error || !OnField(Reader->GetIdentifier(), Notation))
+		{
+			return Fail(Reader->GetErrorMessage());
+		}
+	}
+	return Fail(Reader->GetErrorMessage());
+}
+
+template <typename ElementFuncType>
+bool FBlueprintJsonReader::ReadArray(ElementFuncType&& OnElement)
+{
+	EJsonNotation Notation;
+	while (Reader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ArrayEnd)
+		{
+			return true;
+		}
+		if (Notation == EJsonNotation::Error || !OnElement(Notation))
+		{
+			return Fail(Reader->GetErrorMessage());
+		}
+	}
+	return Fail(Reader->GetErrorMessage());
+}
+
+bool FBlueprintJsonReader::ReadDelta(FBlueprintDeltaData& OutDelta)
+{
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return Fail(TEXT("Expected a JSON object"));
+	}
+
+	FBlueprintStateData RawState;
+	bool bHasRawState = false;
+
+	const bool bRead = ReadObject([&](const FString& Key, EJsonNotation FieldNotation)
+	{
+		if (Key == TEXT("type")) return ReadString(FieldNotation, OutDelta.Type);
+		if (Key == TEXT("removedId")) return ReadString(FieldNotation, OutDelta.RemovedId);
+
+		if (Key == TEXT("version"))
+		{
+			double Version = 0.0;
+			const bool bOk = ReadNumber(FieldNotation, Version);
+			OutDelta.Version = static_cast<int32>(Version);
+			return bOk;
+		}
+
+		if (FieldNotation == EJsonNotation::ObjectStart)
+		{
+			if (Key == TEXT("node")) return ReadNode(OutDelta.Node.Emplace());
+			if (Key == TEXT("connection")) return ReadConnection(OutDelta.Connection.Emplace());
+			if (Key == TEXT("variable")) return ReadVariable(OutDelta.Variable.Emplace());
+			if (Key == TEXT("fullState")) return ReadState(OutDelta.FullState.Emplace());
+		}
+
+		// Fields of a raw state posted without a delta envelope
+		if (Key == TEXT("name"))
+		{
+			return ReadStateField(Key, FieldNotation, RawState);
+		}
+		if (Key == TEXT("nodes") || Key == TEXT("connections") || Key == TEXT("variables"))
+		{
+			bHasRawState = true;
+			return ReadStateField(Key, FieldNotation, RawState);
+		}
+
+		return Skip(FieldNotation);
+	});
+
+	if (!bRead)
+	{
+		return false;
+	}
+
+	if (OutDelta.Type.IsEmpty())
+	{
+		if (!bHasRawState)
+		{
+			return Fail(TEXT("Body is neither a delta nor a blueprint state"));
+		}
+		OutDelta.Type = TEXT("FullSync");
+		OutDelta.FullState = MoveTemp(RawState);
+	}
+
+	return true;
+}
+
+bool FBlueprintJsonReader::ReadBlueprintState(FBlueprintStateData& OutState)
+{
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return Fail(TEXT("Expected a JSON object"));
+	}
+	return ReadState(OutState);
+}
+
+bool FBlueprintJsonReader::ReadCreateRequest(FBlueprintCreateRequest& OutRequest)
+{
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return Fail(TEXT("Expected a JSON object"));
+	}
+
+	return ReadObject([&](const FString& Key, EJsonNotation FieldNotation)
+	{
+		if (Key == TEXT("name")) return ReadString(FieldNotation, OutRequest.Name);
+		if (Key == TEXT("path")) return ReadString(FieldNotation, OutRequest.Path);
+		if (Key == TEXT("parentClass")) return ReadString(FieldNotation, OutRequest.ParentClass);
+		if (Key == TEXT("state") && FieldNotation == EJsonNotation::ObjectStart) return ReadState(OutRequest.State.Emplace());
+		return Skip(FieldNotation);
+	});
+}
+
+bool FBlueprintJsonReader::ReadNameList(TArray<FString>& OutNames)
+{
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return Fail(TEXT("Expected a JSON object"));
+	}
+
+	return ReadObject([&](const FString& Key, EJsonNotation FieldNotation)
+	{
+		if ((Key == TEXT("names") || Key == TEXT("paths")) && FieldNotation == EJsonNotation::ArrayStart)
+		{
+			return ReadArray([&](EJsonNotation E) { return E == EJsonNotation::String ? ReadString(E, OutNames.AddDefaulted_GetRef()) : Skip(E); });
+		}
+		return Skip(FieldNotation);
+	});
+}
+
+bool FBlueprintJsonReader::ReadState(FBlueprintStateData& OutState)
+{
+	return ReadObject([&](const FString& Key, EJsonNotation Notation)
+	{
+		return ReadStateField(Key, Notation, OutState);
+	});
+}
+
+bool FBlueprintJsonReader::ReadStateField(const FString& Key, EJsonNotation Notation, FBlueprintStateData& OutState)
+{
+	if (Key == TEXT("name")) return ReadString(Notation, OutState.Name);
+	if (Notation != EJsonNotation::ArrayStart) return Skip(Notation);
+
+	if (Key == TEXT("nodes"))
+	{
+		return ReadArray([&](EJsonNotation E) { return E == EJsonNotation::ObjectStart ? ReadNode(OutState.Nodes.AddDefaulted_GetRef()) : Skip(E); });
+	}
+	if (Key == TEXT("connections"))
+	{
+		return ReadArray([&](EJsonNotation E) { return E == EJsonNotation::ObjectStart ? ReadConnection(OutState.Connections.AddDefaulted_GetRef()) : Skip(E); });
+	}
+	if (Key == TEXT("variables"))
+	{
+		OutState.bHasVariables = true;
+		return ReadArray([&](EJsonNotation E) { return E == EJsonNotation::ObjectStart ? ReadVariable(OutState.Variables.AddDefaulted_GetRef()) : Skip(E); });
+	}
+	return Skip(Notation);
+}
+
+bool FBlueprintJsonReader::ReadNode(FBlueprintNodeData& OutNode)
+{
+	return ReadObject([&](const FString& Key, EJsonNotation Notation)
+	{
+		if (Key == TEXT("id")) return ReadString(Notation, OutNode.Id);
+		if (Key == TEXT("title")) return ReadString(Notation, OutNode.Title);
+		if (Key == TEXT("category")) return ReadString(Notation, OutNode.Category);
+		if (Key == TEXT("style")) return ReadString(Notation, OutNode.Style);
+		if (Key == TEXT("isCompact")) return ReadBool(Notation, OutNode.bIsCompact);
+
+		if (Key == TEXT("positionX") || Key == TEXT("positionY"))
+		{
+			double Position = 0.0;
+			const bool bOk = ReadNumber(Notation, Position);
+			(Key == TEXT("positionX") ? OutNode.PosX : OutNode.PosY) = static_cast<int32>(Position);
+			return bOk;
+		}
+
+		if (Notation == EJsonNotation::ArrayStart)
+		{
+			if (Key == TEXT("inputPins")) return ReadPins(OutNode.InputPins);
+			if (Key == TEXT("outputPins")) return ReadPins(OutNode.OutputPins);
+		}
+
+		return Skip(Notation);
+	});
+}
+
+bool FBlueprintJsonReader::ReadPins(TArray<FBlueprintPinData>& OutPins)
+{
+	return ReadArray([&](EJsonNotation ElementNotation)
+	{
+		if (ElementNotation != EJsonNotation::ObjectStart)
+		{
+			return Skip(ElementNotation);
+		}
+
+		FBlueprintPinData& Pin = OutPins.AddDefaulted_GetRef();
+		return ReadObject([&](const FString& Key, EJsonNotation Notation)
+		{
+			if (Key == TEXT("id")) return ReadString(Notation, Pin.Id);
+			if (Key == TEXT("name")) return ReadString(Notation, Pin.Name);
+			if (Key == TEXT("type")) return ReadString(Notation, Pin.Type);
+			if (Key == TEXT("subType")) return ReadString(Notation, Pin.SubType);
+			if (Key == TEXT("isConnected")) return ReadBool(Notation, Pin.bIsConnected);
+			if (Key == TEXT("defaultValue"))
+			{
+				Pin.bHasDefaultValue = Notation == EJsonNotation::String || Notation == EJsonNotation::Number || Notation == EJsonNotation::Boolean;
+				return ReadDefaultValue(Notation, Pin.DefaultValue);
+			}
+			return Skip(Notation);
+		});
+	});
+}
+
+bool FBlueprintJsonReader::ReadConnection(FBlueprintConnectionData& OutConnection)
+{
+	return ReadObject([&](const FString& Key, EJsonNotation Notation)
+	{
+		if (Key == TEXT("id")) return ReadString(Notation, OutConnection.Id);
+		if (Key == TEXT("sourceNodeId")) return ReadString(Notation, OutConnection.SourceNodeId);
+		if (Key == TEXT("sourcePinId")) return ReadString(Notation, OutConnection.SourcePinId);
+		if (Key == TEXT("targetNodeId")) return ReadString(Notation, OutConnection.TargetNodeId);
+		if (Key == TEXT("targetPinId")) return ReadString(Notation, OutConnection.TargetPinId);
+		if (Key == TEXT("pinType")) return ReadString(Notation, OutConnection.PinType);
+		return Skip(Notation);
+	});
+}
+
+bool FBlueprintJsonReader::ReadVariable(FBlueprintVariableData& OutVariable)
+{
+	return ReadObject([&](const FString& Key, EJsonNotation Notation)
+	{
+		if (Key == TEXT("id")) return ReadString(Notation, OutVariable.Id);
+		if (Key == TEXT("name")) return ReadString(Notation, OutVariable.Name);
+		if (Key == TEXT("type")) return ReadString(Notation, OutVariable.Type);
+		if (Key == TEXT("defaultValue")) return ReadDefaultValue(Notation, OutVariable.DefaultValue);
+		if (Key == TEXT("category")) return ReadString(Notation, OutVariable.Category);
+		if (Key == TEXT("isEditable")) return ReadBool(Notation, OutVariable.bIsEditable);
+		return Skip(Notation);
+	});
+}
+
+bool FBlueprintJsonReader::ReadString(EJsonNotation Notation, FString& OutValue)
+{
+	if (Notation == EJsonNotation::String)
+	{
+		OutValue = Reader->GetValueAsString();
+		return true;
+	}
+	return Skip(Notation);
+}
+
+bool FBlueprintJsonReader::ReadDefaultValue(EJsonNotation Notation, FString& OutValue)
+{
+	// Exports send defaults as strings, but hand-written payloads send 5 or true; take them as FJsonValue::TryGetString would
+	switch (Notation)
+	{
+	case EJsonNotation::Number:
+		OutValue = FString::SanitizeFloat(Reader->GetValueAsNumber(), 0);
+		return true;
+	case EJsonNotation::Boolean:
+		OutValue = Reader->GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+		return true;
+	default:
+		return ReadString(Notation, OutValue);
+	}
+}
+
+bool FBlueprintJsonReader::ReadNumber(EJsonNotation Notation, double& OutValue)
+{
+	if (Notation == EJsonNotation::Number)
+	{
+		OutValue = Reader->GetValueAsNumber();
+		return true;
+	}
+	return Skip(Notation);
+}
+
+bool FBlueprintJsonReader::ReadBool(EJsonNotation Notation, bool& OutValue)
+{
+	if (Notation == EJsonNotation::Boolean)
+	{
+		OutValue = Reader->GetValueAsBoolean();
+		return true;
+	}
+	return Skip(Notation);
+}
+
+bool FBlueprintJsonReader::Skip(EJsonNotation Notation)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::ObjectStart:
+		return Reader->SkipObject();
+	case EJsonNotation::ArrayStart:
+		return Reader->SkipArray();
+	case EJsonNotation::Error:
+		return false;
+	default:
+		// Scalars and nulls were fully consumed by ReadNext
+		return true;
+	}
+}
+
+bool FBlueprintJsonReader::Fail(const FString& Message)
+{
+	if (Error.IsEmpty())
+	{
+		Error = Message.IsEmpty() ? TEXT("Malformed JSON") : Message;
+	}
+	return false;
+}
@@ -0,0 +1,298 @@
+#include "BlueprintLookupIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Editor.h"
+#include "Misc/PackageName.h"
+
+FBlueprintLookupIndex::FBlueprintLookupIndex()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FBlueprintLookupIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FBlueprintLookupIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FBlueprintLookupIndex::OnAssetRenamed);
+
+	// Whatever the registry has found so far; assets discovered by the rest of the startup scan arrive through OnAssetAdded
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	for (const FAssetData& AssetData : Assets)
+	{
+		IndexAsset(AssetData);
+	}
+
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+	{
+		AssetOpenedHandle = AssetEditorSubsystem->OnAssetOpenedInEditor().AddRaw(this, &FBlueprintLookupIndex::OnAssetOpened);
+		AssetClosedHandle = AssetEditorSubsystem->OnAssetClosedInEditor().AddRaw(this, &FBlueprintLookupIndex::OnAssetClosed);
+
+		for (UObject* Asset : AssetEditorSubsystem->GetAllEditedAssets())
+		{
+			OnAssetOpened(Asset, nullptr);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Indexed %d blueprint asset names, %d open"), AssetsByName.Num(), OpenBlueprints.Num());
+}
+
+FBlueprintLookupIndex::~FBlueprintLookupIndex()
+{
+	// Waiters capture the handler, which is going away with us; drop them rather than complete them
+	TMap<FSoftObjectPath, FPendingLoad> Abandoned = MoveTemp(PendingLoads);
+	PendingLoads.Empty();
+	for (TPair<FSoftObjectPath, FPendingLoad>& Pair : Abandoned)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->CancelHandle();
+		}
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+	{
+		AssetEditorSubsystem->OnAssetOpenedInEditor().Remove(AssetOpenedHandle);
+		AssetEditorSubsystem->OnAssetClosedInEditor().Remove(AssetClosedHandle);
+	}
+}
+
+UBlueprint* FBlueprintLookupIndex::Find(const FString& NameOrPath)
+{
+	if (const TWeakObjectPtr<UBlueprint>* Known = Loaded.Find(NameOrPath))
+	{
+		if (UBlueprint* Blueprint = Known->Get())
+		{
+			return Blueprint;
+		}
+		Loaded.Remove(NameOrPath);
+	}
+
+	// Loaded by something else (a reference, a content browser thumbnail) since we last looked
+	const FSoftObjectPath AssetPath = FindAssetPath(NameOrPath);
+	UBlueprint* Blueprint = AssetPath.IsNull() ? nullptr : Cast<UBlueprint>(AssetPath.ResolveObject());
+	if (Blueprint)
+	{
+		Remember(Blueprint);
+	}
+	return Blueprint;
+}
+
+bool FBlueprintLookupIndex::LoadAsync(const TArray<FString>& Names, TFunction<void()>&& OnLoaded)
+{
+	TSharedRef<FLoadGroup> Group = MakeShared<FLoadGroup>();
+	Group->OnLoaded = MoveTemp(OnLoaded);
+
+	for (const FString& Name : Names)
+	{
+		if (Find(Name))
+		{
+			continue;
+		}
+
+		const FSoftObjectPath AssetPath = FindAssetPath(Name);
+		if (AssetPath.IsNull() || FailedLoads.Contains(AssetPath))
+		{
+			continue;
+		}
+
+		Group->Remaining++;
+		if (FPendingLoad* Pending = PendingLoads.Find(AssetPath))
+		{
+			Pending->Groups.Add(Group);
+			continue;
+		}
+
+		// Register before requesting: the streamable manager may complete the load inside the call
+		FPendingLoad& Pending = PendingLoads.Add(AssetPath);
+		Pending.Groups.Add(Group);
+		Pending.StartTime = FPlatformTime::Seconds();
+		TSharedPtr<FStreamableHandle> Handle = Streamable.RequestAsyncLoad(AssetPath,
+			FStreamableDelegate::CreateRaw(this, &FBlueprintLookupIndex::OnLoadComplete, AssetPath), FStreamableManager::AsyncLoadHighPriority);
+		if (FPendingLoad* StillPending = PendingLoads.Find(AssetPath))
+		{
+			StillPending->Handle = Handle;
+		}
+	}
+
+	if (Group->Remaining == 1)
+	{
+		return false;
+	}
+	Release(Group);
+	return true;
+}
+
+void FBlueprintLookupIndex::Release(const TSharedRef<FLoadGroup>& Group)
+{
+	if (--Group->Remaining == 0)
+	{
+		Group->OnLoaded();
+	}
+}
+
+void FBlueprintLookupIndex::OnLoadComplete(FSoftObjectPath AssetPath)
+{
+	FPendingLoad Pending;
+	if (!PendingLoads.RemoveAndCopyValue(AssetPath, Pending))
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(AssetPath.ResolveObject());
+	if (Blueprint)
+	{
+		Remember(Blueprint);
+		UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Streamed in %s for %d waiting request group(s) in %.2f ms"),
+			*AssetPath.ToString(), Pending.Groups.Num(), (FPlatformTime::Seconds() - Pending.StartTime) * 1000.0);
+	}
+	else
+	{
+		FailedLoads.Add(AssetPath);
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Failed to load blueprint %s"), *AssetPath.ToString());
+	}
+
+	for (const TSharedRef<FLoadGroup>& Group : Pending.Groups)
+	{
+		Group->Handles.Add(Pending.Handle);
+		Release(Group);
+	}
+}
+
+TArray<UBlueprint*> FBlueprintLookupIndex::GetOpenBlueprints() const
+{
+	TArray<UBlueprint*> Result;
+	Result.Reserve(OpenBlueprints.Num());
+	for (const TWeakObjectPtr<UBlueprint>& Open : OpenBlueprints)
+	{
+		if (UBlueprint* Blueprint = Open.Get())
+		{
+			Result.Add(Blueprint);
+		}
+	}
+	return Result;
+}
+
+FSoftObjectPath FBlueprintLookupIndex::FindAssetPath(const FString& NameOrPath) const
+{
+	if (!NameOrPath.StartsWith(TEXT("/")))
+	{
+		const TArray<FSoftObjectPath>* Candidates = AssetsByName.Find(FName(*NameOrPath));
+		if (!Candidates || Candidates->Num() == 0)
+		{
+			return FSoftObjectPath();
+		}
+		if (Candidates->Num() > 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: '%s' names %d blueprint assets; using %s (pass a path to pick another)"),
+				*NameOrPath, Candidates->Num(), *(*Candidates)[0].ToString());
+		}
+		return (*Candidates)[0];
+	}
+
+	// "/Game/AI/BP_Enemy" is shorthand for "/Game/AI/BP_Enemy.BP_Enemy"
+	FString ObjectPath = NameOrPath;
+	if (!ObjectPath.Contains(TEXT(".")))
+	{
+		ObjectPath = FString::Printf(TEXT("%s.%s"), *NameOrPath, *FPackageName::GetShortName(NameOrPath));
+	}
+
+	// Only hand back paths the registry knows, so a typo doesn't turn into a failed load
+	const FSoftObjectPath AssetPath(ObjectPath);
+	const TArray<FSoftObjectPath>* Candidates = AssetsByName.Find(FName(*AssetPath.GetAssetName()));
+	return Candidates && Candidates->Contains(AssetPath) ? AssetPath : FSoftObjectPath();
+}
+
+void FBlueprintLookupIndex::Remember(UBlueprint* Blueprint)
+{
+	Loaded.Add(Blueprint->GetName(), Blueprint);
+	Loaded.Add(Blueprint->GetPathName(), Blueprint);
+	Loaded.Add(Blueprint->GetOutermost()->GetName(), Blueprint);
+}
+
+void FBlueprintLookupIndex::Forget(const UBlueprint* Blueprint)
+{
+	for (auto It = Loaded.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid() || It.Value().Get() == Blueprint)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FBlueprintLookupIndex::IndexAsset(const FAssetData& AssetData)
+{
+	AssetsByName.FindOrAdd(AssetData.AssetName).AddUnique(AssetData.GetSoftObjectPath());
+	FailedLoads.Remove(AssetData.GetSoftObjectPath());
+}
+
+void FBlueprintLookupIndex::UnindexAsset(FName AssetName, const FSoftObjectPath& AssetPath)
+{
+	if (TArray<FSoftObjectPath>* Paths = AssetsByName.Find(AssetName))
+	{
+		Paths->Remove(AssetPath);
+		if (Paths->Num() == 0)
+		{
+			AssetsByName.Remove(AssetName);
+		}
+	}
+}
+
+void FBlueprintLookupIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	// Blueprint classes are native, so GetClass() never has to load anything here
+	UClass* AssetClass = AssetData.GetClass();
+	if (AssetClass && AssetClass->IsChildOf(UBlueprint::StaticClass()))
+	{
+		IndexAsset(AssetData);
+	}
+}
+
+void FBlueprintLookupIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	UnindexAsset(AssetData.AssetName, AssetData.GetSoftObjectPath());
+}
+
+void FBlueprintLookupIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	const FSoftObjectPath OldPath(OldObjectPath);
+	if (!AssetsByName.Contains(FName(*OldPath.GetAssetName())))
+	{
+		return;
+	}
+
+	UnindexAsset(FName(*OldPath.GetAssetName()), OldPath);
+	IndexAsset(AssetData);
+
+	// A loaded blueprint is still filed under its old name and path
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+	{
+		Forget(Blueprint);
+		Remember(Blueprint);
+	}
+}
+
+void FBlueprintLookupIndex::OnAssetOpened(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		OpenBlueprints.Add(Blueprint);
+		Remember(Blueprint);
+	}
+}
+
+void FBlueprintLookupIndex::OnAssetClosed(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	// Closing a tab does not unload the blueprint, so it stays resolvable by name
+	OpenBlueprints.Remove(Cast<UBlueprint>(Asset));
+}
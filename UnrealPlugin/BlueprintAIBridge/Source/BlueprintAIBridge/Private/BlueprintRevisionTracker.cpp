@@ -0,0 +1,177 @@
+#include "BlueprintRevisionTracker.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "UObject/Package.h"
+
+FBlueprintRevisionTracker::FBlueprintRevisionTracker()
+	: SessionTag(FGuid::NewGuid().A)
+{
+	PackageDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FBlueprintRevisionTracker::OnPackageMarkedDirty);
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FBlueprintRevisionTracker::OnObjectModified);
+}
+
+FBlueprintRevisionTracker::~FBlueprintRevisionTracker()
+{
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageDirtyHandle);
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+
+	for (auto& Pair : Watches)
+	{
+		if (UBlueprint* Blueprint = Pair.Key.Get())
+		{
+			Unwatch(Blueprint, Pair.Value);
+		}
+	}
+	Watches.Empty();
+}
+
+uint64 FBlueprintRevisionTracker::GetRevision(UBlueprint* Blueprint)
+{
+	return Blueprint ? Watch(Blueprint).Revision : 0;
+}
+
+FString FBlueprintRevisionTracker::MakeETag(UBlueprint* Blueprint, const TCHAR* Representation)
+{
+	return FString::Printf(TEXT("\"%08x-%llu-%s\""), SessionTag, GetRevision(Blueprint), Representation);
+}
+
+FBlueprintRevisionTracker::FWatch& FBlueprintRevisionTracker::Watch(UBlueprint* Blueprint)
+{
+	if (FWatch* Existing = Watches.Find(Blueprint))
+	{
+		return *Existing;
+	}
+
+	// Drop blueprints that were unloaded since the last lookup
+	for (auto It = Watches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FWatch& Entry = Watches.Add(Blueprint);
+	Entry.Revision = NextRevision++;
+	Entry.ChangedHandle = Blueprint->OnChanged().AddRaw(this, &FBlueprintRevisionTracker::OnBlueprintChanged);
+	Entry.CompiledHandle = Blueprint->OnCompiled().AddRaw(this, &FBlueprintRevisionTracker::OnBlueprintCompiled);
+	WatchGraphs(Blueprint, Entry);
+	return Entry;
+}
+
+void FBlueprintRevisionTracker::WatchGraphs(UBlueprint* Blueprint, FWatch& Entry)
+{
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
+	{
+		if (Graph && !Entry.GraphHandles.Contains(Graph))
+		{
+			Entry.GraphHandles.Add(Graph, Graph->AddOnGraphChangedHandler(
+				FOnGraphChanged::FDelegate::CreateRaw(this, &FBlueprintRevisionTracker::OnGraphChanged, TWeakObjectPtr<UBlueprint>(Blueprint))));
+		}
+	}
+}
+
+void FBlueprintRevisionTracker::Unwatch(UBlueprint* Blueprint, FWatch& Entry)
+{
+	Blueprint->OnChanged().Remove(Entry.ChangedHandle);
+	Blueprint->OnCompiled().Remove(Entry.CompiledHandle);
+	for (const auto& GraphPair : Entry.GraphHandles)
+	{
+		if (UEdGraph* Graph = GraphPair.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(GraphPair.Value);
+		}
+	}
+	Entry.GraphHandles.Empty();
+}
+
+void FBlueprintRevisionTracker::Bump(UBlueprint* Blueprint)
+{
+	if (FWatch* Entry = Watches.Find(Blueprint))
+	{
+		Entry->Revision = NextRevision++;
+		RevisionChangedEvent.Broadcast(Blueprint);
+	}
+}
+
+void FBlueprintRevisionTracker::OnBlueprintChanged(UBlueprint* Blueprint)
+{
+	if (Watches.Contains(Blueprint))
+	{
+		StructureChangedEvent.Broadcast(Blueprint);
+	}
+	OnBlueprintCompiled(Blueprint);
+}
+
+void FBlueprintRevisionTracker::OnBlueprintCompiled(UBlueprint* Blueprint)
+{
+	Bump(Blueprint);
+
+	// Structural changes may have added function graphs we aren't listening to yet
+	if (FWatch* Entry = Watches.Find(Blueprint))
+	{
+		WatchGraphs(Blueprint, *Entry);
+	}
+}
+
+void FBlueprintRevisionTracker::OnGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UBlueprint> Blueprint)
+{
+	if (UBlueprint* Owner = Blueprint.Get())
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			if (Node)
+			{
+				NodeChangedEvent.Broadcast(Owner, Node);
+			}
+		}
+		Bump(Owner);
+	}
+}
+
+void FBlueprintRevisionTracker::OnPackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	// Catches edits that only Modify() the graph (node moves, pin default tweaks)
+	TArray<UBlueprint*> Dirtied;
+	for (const auto& Pair : Watches)
+	{
+		UBlueprint* Blueprint = Pair.Key.Get();
+		if (Blueprint && Blueprint->GetOutermost() == Package)
+		{
+			Dirtied.Add(Blueprint);
+		}
+	}
+	for (UBlueprint* Blueprint : Dirtied)
+	{
+		Bump(Blueprint);
+	}
+}
+
+void FBlueprintRevisionTracker::OnObjectModified(UObject* Object)
+{
+	// Fires for every Modify() in the editor, so bail out cheaply for anything outside a watched blueprint
+	if (Watches.Num() == 0)
+	{
+		return;
+	}
+
+	if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		UBlueprint* Blueprint = Node->GetTypedOuter<UBlueprint>();
+		if (Blueprint && Watches.Contains(Blueprint))
+		{
+			NodeChangedEvent.Broadcast(Blueprint, Node);
+		}
+	}
+	else if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		// Variable and class-setting edits Modify() the blueprint itself
+		if (Watches.Contains(Blueprint))
+		{
+			StructureChangedEvent.Broadcast(Blueprint);
+		}
+	}
+}
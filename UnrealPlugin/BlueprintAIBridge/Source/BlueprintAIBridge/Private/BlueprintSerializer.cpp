@@ -15,144 +15,632 @@
 #include "K2Node_MacroInstance.h"
 #include "K2Node_Composite.h"
 #include "K2Node_Knot.h"
-#include "Serialization/JsonSerializer.h"
+#include "Async/Async.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectGlobals.h"
 
-TSharedPtr<FJsonObject> FBlueprintSerializer::SerializeBlueprint(UBlueprint* Blueprint)
+FBlueprintSerializer::FBlueprintSerializer()
 {
-	ClearMappings();
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FBlueprintSerializer::OnObjectModified);
+}
 
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	Root->SetStringField(TEXT("name"), Blueprint->GetName());
+FBlueprintSerializer::~FBlueprintSerializer()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+}
 
-	// Gather all event graphs
-	TArray<UEdGraph*> Graphs;
+FString FBlueprintExportQuery::ToKey() const
+{
+	TArray<FString> Guids;
+	Guids.Reserve(NodeGuids.Num());
+	for (const FGuid& Guid : NodeGuids)
+	{
+		Guids.Add(Guid.ToString());
+	}
+	Guids.Sort();
+
+	FString RegionKey;
+	if (Region.IsSet())
+	{
+		RegionKey = FString::Printf(TEXT("%g,%g,%g,%g"), Region->Min.X, Region->Min.Y, Region->Max.X, Region->Max.Y);
+	}
+	return FString::Printf(TEXT("graph=%s;region=%s;nodes=%s;hops=%d;fields=%d"),
+		*Graph.ToLower(), *RegionKey, *FString::Join(Guids, TEXT(",")), NodeGuids.Num() > 0 ? Hops : 0, static_cast<int32>(Fields));
+}
+
+TArray<uint8> FBlueprintSerializer::SerializeBlueprint(UBlueprint* Blueprint, EBlueprintWireFormat Format, const FBlueprintExportQuery& Query)
+{
+	TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Snapshot = Capture(Blueprint, Format, Query);
+	TArray<uint8> Output = Encode(*Snapshot);
+	AdoptEncodedNodes(*Snapshot, Output.Num());
+	return Output;
+}
+
+void FBlueprintSerializer::SerializeBlueprintAsync(UBlueprint* Blueprint, EBlueprintWireFormat Format, FOnExportEncoded&& OnEncoded,
+	const FBlueprintExportQuery& Query)
+{
+	TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Snapshot = Capture(Blueprint, Format, Query);
+	TWeakPtr<FBlueprintSerializer> WeakThis = AsShared();
+
+	Async(EAsyncExecution::TaskGraph, [WeakThis, Snapshot, OnEncoded = MoveTemp(OnEncoded)]() mutable
+	{
+		TArray<uint8> Output = Encode(*Snapshot);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Snapshot, Output = MoveTemp(Output), OnEncoded = MoveTemp(OnEncoded)]() mutable
+		{
+			TSharedPtr<FBlueprintSerializer> This = WeakThis.Pin();
+			if (!This.IsValid())
+			{
+				return;
+			}
+			This->AdoptEncodedNodes(*Snapshot, Output.Num());
+			OnEncoded(MoveTemp(Output), *Snapshot);
+		});
+	});
+}
+
+bool FBlueprintSerializer::GatherGraphs(UBlueprint* Blueprint, const FString& GraphName, TArray<UEdGraph*>& OutGraphs)
+{
 	for (UEdGraph* Graph : Blueprint->UbergraphPages)
 	{
-		Graphs.Add(Graph);
+		if (GraphName.IsEmpty() || Graph->GetName() == GraphName)
+		{
+			OutGraphs.Add(Graph);
+		}
 	}
 	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
 	{
-		Graphs.Add(Graph);
+		if (GraphName.IsEmpty() || Graph->GetName() == GraphName)
+		{
+			OutGraphs.Add(Graph);
+		}
 	}
+	return GraphName.IsEmpty() || OutGraphs.Num() > 0;
+}
 
-	// Serialize nodes
-	TArray<TSharedPtr<FJsonValue>> NodesArray;
+void FBlueprintSerializer::SelectNodes(const TArray<UEdGraph*>& Graphs, const FBlueprintExportQuery& Query, TArray<UK2Node*>& OutNodes)
+{
+	auto InRegion = [&Query](const UK2Node* Node)
+	{
+		if (!Query.Region.IsSet())
+		{
+			return true;
+		}
+		const FBox2D& Region = Query.Region.GetValue();
+		return Node->NodePosX >= Region.Min.X && Node->NodePosX <= Region.Max.X
+			&& Node->NodePosY >= Region.Min.Y && Node->NodePosY <= Region.Max.Y;
+	};
+
+	if (Query.NodeGuids.Num() == 0)
+	{
+		for (UEdGraph* Graph : Graphs)
+		{
+			for (UEdGraphNode* Node : Graph->Nodes)
+			{
+				UK2Node* K2Node = Cast<UK2Node>(Node);
+				if (K2Node && InRegion(K2Node))
+				{
+					OutNodes.Add(K2Node);
+				}
+			}
+		}
+		return;
+	}
+
+	// Seed nodes, then breadth-first along pin links, one ring per hop
+	TSet<UK2Node*> Selected;
+	TArray<UK2Node*> Frontier;
 	for (UEdGraph* Graph : Graphs)
 	{
 		for (UEdGraphNode* Node : Graph->Nodes)
 		{
 			UK2Node* K2Node = Cast<UK2Node>(Node);
-			if (K2Node)
+			if (K2Node && Query.NodeGuids.Contains(FBlueprintIdRegistry::GetNodeGuid(K2Node)))
 			{
-				TSharedPtr<FJsonObject> NodeJson = SerializeNode(K2Node);
-				if (NodeJson.IsValid())
+				Selected.Add(K2Node);
+				Frontier.Add(K2Node);
+			}
+		}
+	}
+
+	for (int32 Hop = 0; Hop < Query.Hops && Frontier.Num() > 0; ++Hop)
+	{
+		TArray<UK2Node*> NextFrontier;
+		for (UK2Node* Node : Frontier)
+		{
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
 				{
-					NodesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
+					UK2Node* Neighbor = Cast<UK2Node>(LinkedPin->GetOwningNode());
+					bool bAlreadySelected = true;
+					if (Neighbor)
+					{
+						Selected.Add(Neighbor, &bAlreadySelected);
+					}
+					if (!bAlreadySelected)
+					{
+						NextFrontier.Add(Neighbor);
+					}
 				}
 			}
 		}
+		Frontier = MoveTemp(NextFrontier);
 	}
-	Root->SetArrayField(TEXT("nodes"), NodesArray);
 
-	// Serialize connections
-	TArray<TSharedPtr<FJsonValue>> AllConnections;
-	for (UEdGraph* Graph : Graphs)
+	for (UK2Node* Node : Selected)
 	{
-		TArray<TSharedPtr<FJsonValue>> GraphConnections = SerializeConnections(Graph);
-		AllConnections.Append(GraphConnections);
+		if (InRegion(Node))
+		{
+			OutNodes.Add(Node);
+		}
 	}
-	Root->SetArrayField(TEXT("connections"), AllConnections);
+}
 
-	// Comments as empty array for now
-	Root->SetArrayField(TEXT("comments"), TArray<TSharedPtr<FJsonValue>>());
+TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> FBlueprintSerializer::Capture(UBlueprint* Blueprint, EBlueprintWireFormat Format,
+	const FBlueprintExportQuery& Query)
+{
+	check(IsInGameThread());
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bPartial = !Query.IsFull();
 
-	// Serialize variables
-	Root->SetArrayField(TEXT("variables"), SerializeVariables(Blueprint));
+	TArray<UEdGraph*> Graphs;
+	GatherGraphs(Blueprint, Query.Graph, Graphs);
+	TArray<UK2Node*> Nodes;
+	SelectNodes(Graphs, Query, Nodes);
+
+	// Size the registry up front so large graphs don't rehash during the export
+	int32 PinCount = 0;
+	for (UK2Node* Node : Nodes)
+	{
+		PinCount += Node->Pins.Num();
+	}
+	Registry.Reset(Nodes.Num(), PinCount);
+
+	if (ExportedBlueprint.Get() != Blueprint)
+	{
+		Fragments.Empty();
+		ExportedBlueprint = Blueprint;
+	}
+	ExportCounter++;
+
+	TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FBlueprintExportSnapshot, ESPMode::ThreadSafe>();
+	Snapshot->Name = Blueprint->GetName();
+	Snapshot->Format = Format;
+	Snapshot->Fields = Query.Fields;
+	Snapshot->bPartial = bPartial;
+	Snapshot->SizeHint = Format == EBlueprintWireFormat::Json && !bPartial ? LastExportSize : 0;
+	Snapshot->Nodes.Reserve(Nodes.Num());
+
+	for (UK2Node* Node : Nodes)
+	{
+		CaptureNode(Node, *Snapshot);
+	}
 
-	return Root;
+	if (EnumHasAnyFlags(Query.Fields, EBlueprintExportFields::Connections))
+	{
+		CaptureConnections(Nodes, Snapshot->Connections);
+	}
+
+	if (EnumHasAnyFlags(Query.Fields, EBlueprintExportFields::Variables))
+	{
+		CaptureVariables(Blueprint, Snapshot->Variables);
+	}
+
+	// Only a full export has seen every node, so only it can tell which fragments belong to deleted nodes
+	if (!bPartial)
+	{
+		for (auto It = Fragments.CreateIterator(); It; ++It)
+		{
+			if (It.Value().LastExport != ExportCounter)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		DirtyNodes.Reset();
+	}
+
+	Snapshot->CaptureSeconds = FPlatformTime::Seconds() - StartTime;
+	return Snapshot;
 }
 
-TSharedPtr<FJsonObject> FBlueprintSerializer::SerializeNode(UK2Node* Node)
+void FBlueprintSerializer::CaptureNode(UK2Node* Node, FBlueprintExportSnapshot& Snapshot)
 {
-	TSharedPtr<FJsonObject> NodeJson = MakeShared<FJsonObject>();
+	// Derive stable ID from the node GUID and store mapping
+	FString NodeId = FBlueprintIdRegistry::MakeNodeId(Node);
+	if (Registry.FindNode(NodeId))
+	{
+		// Duplicated GUID (e.g. hand-edited asset); keep IDs unique using the node path instead
+		NodeId = FGuid::NewDeterministicGuid(Node->GetPathName()).ToString(EGuidFormats::DigitsWithHyphensLower);
+	}
+	Registry.RegisterNode(NodeId, Node);
+
+	// Reuse the node's encoded fragment unless it was modified or its pins/links/position moved on
+	const uint32 Fingerprint = ComputeFingerprint(Node);
+	const bool bDirty = DirtyNodes.Contains(Node);
+	FNodeFragment Scratch;
+	FNodeFragment* FragmentPtr = nullptr;
+	if (Snapshot.bPartial)
+	{
+		// A partial export may read a current fragment but never writes one: the fragment cache, its pruning
+		// and the dirty set all belong to full exports, which are the only ones that see every node
+		FNodeFragment* Existing = Fragments.Find(NodeId);
+		FragmentPtr = Existing && Existing->Generation != 0 && Existing->Fingerprint == Fingerprint && !bDirty ? Existing : &Scratch;
+	}
+	else
+	{
+		FragmentPtr = &Fragments.FindOrAdd(NodeId);
+		if (FragmentPtr->Generation == 0 || FragmentPtr->Fingerprint != Fingerprint || bDirty)
+		{
+			*FragmentPtr = FNodeFragment();
+			FragmentPtr->Fingerprint = Fingerprint;
+			FragmentPtr->Generation = NextFragmentGeneration++;
+		}
+		FragmentPtr->LastExport = ExportCounter;
+		DirtyNodes.Remove(Node);
+	}
+	FNodeFragment& Fragment = *FragmentPtr;
+
+	if (Fragment.PinIds.Num() != Node->Pins.Num())
+	{
+		Fragment.PinIds.Reset(Node->Pins.Num());
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			Fragment.PinIds.Add(Pin->bHidden ? FString() : FBlueprintIdRegistry::MakePinId(Pin));
+		}
+	}
+	for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+	{
+		if (!Fragment.PinIds[PinIndex].IsEmpty())
+		{
+			Registry.RegisterPin(Fragment.PinIds[PinIndex], Node->Pins[PinIndex]);
+		}
+	}
 
-	// Generate stable ID and store mapping
-	FString NodeId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
-	NodeMap.Add(NodeId, Node);
+	FBlueprintExportSnapshot::FNode& Captured = Snapshot.Nodes.AddDefaulted_GetRef();
+	Captured.Id = NodeId;
+	Captured.Generation = Fragment.Generation;
 
-	NodeJson->SetStringField(TEXT("id"), NodeId);
-	NodeJson->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-	NodeJson->SetStringField(TEXT("category"), Node->GetMenuCategory().ToString());
-	NodeJson->SetStringField(TEXT("style"), MapNodeStyle(Node));
-	NodeJson->SetNumberField(TEXT("positionX"), Node->NodePosX);
-	NodeJson->SetNumberField(TEXT("positionY"), Node->NodePosY);
-	NodeJson->SetBoolField(TEXT("isCompact"), Node->ShouldDrawCompact());
+	// Fragments hold every field, so a projected export can neither use nor refill them
+	const bool bCompactBinary = Snapshot.Format == EBlueprintWireFormat::CompactBinary;
+	const bool bAllFields = Snapshot.Fields == EBlueprintExportFields::All;
+	if (bAllFields && bCompactBinary && Fragment.CompactBinary.IsSet())
+	{
+		Captured.CompactBinary = Fragment.CompactBinary;
+	}
+	else if (bAllFields && !bCompactBinary && Fragment.Json.IsValid())
+	{
+		Captured.Json = Fragment.Json;
+	}
+	else
+	{
+		// Titles and categories are FText and must be resolved here; the encoder only sees strings
+		CaptureNodeData(Node, NodeId, Fragment.PinIds, Snapshot.Fields, Captured.Data.Emplace());
+		Snapshot.CapturedNodeCount++;
+	}
+}
 
-	// Serialize pins
-	TArray<TSharedPtr<FJsonValue>> InputPins;
-	TArray<TSharedPtr<FJsonValue>> OutputPins;
+void FBlueprintSerializer::CaptureNodeData(UK2Node* Node, const FString& NodeId, const TArray<FString>& PinIds, EBlueprintExportFields Fields,
+	FBlueprintNodeData& OutNode) const
+{
+	OutNode.Id = NodeId;
+	OutNode.PosX = Node->NodePosX;
+	OutNode.PosY = Node->NodePosY;
 
-	for (UEdGraphPin* Pin : Node->Pins)
+	// Titles and menu categories are the expensive part of a node; skip whatever the query leaves out
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Title))
+	{
+		OutNode.Title = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+	}
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Category))
+	{
+		OutNode.Category = Node->GetMenuCategory().ToString();
+	}
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Style))
 	{
+		OutNode.Style = MapNodeStyle(Node);
+		OutNode.bIsCompact = Node->ShouldDrawCompact();
+	}
+	if (!EnumHasAnyFlags(Fields, EBlueprintExportFields::Pins))
+	{
+		return;
+	}
+
+	for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+	{
+		UEdGraphPin* Pin = Node->Pins[PinIndex];
 		if (Pin->bHidden)
 		{
 			continue;
 		}
 
-		TSharedPtr<FJsonObject> PinJson = SerializePin(Pin);
-		if (PinJson.IsValid())
+		FBlueprintPinData& PinData = (Pin->Direction == EGPD_Input ? OutNode.InputPins : OutNode.OutputPins).AddDefaulted_GetRef();
+		PinData.Id = PinIds[PinIndex];
+		PinData.Name = Pin->GetDisplayName().ToString();
+		PinData.Type = MapPinType(Pin);
+		PinData.bIsConnected = Pin->LinkedTo.Num() > 0;
+		PinData.DefaultValue = Pin->DefaultValue;
+		PinData.bHasDefaultValue = !Pin->DefaultValue.IsEmpty();
+
+		// SubType for struct/object pins
+		if (Pin->PinType.PinSubCategoryObject.IsValid())
 		{
-			if (Pin->Direction == EGPD_Input)
-			{
-				InputPins.Add(MakeShared<FJsonValueObject>(PinJson));
-			}
-			else
-			{
-				OutputPins.Add(MakeShared<FJsonValueObject>(PinJson));
-			}
+			PinData.SubType = Pin->PinType.PinSubCategoryObject->GetName();
+		}
+	}
+}
+
+void FBlueprintSerializer::AdoptEncodedNodes(const FBlueprintExportSnapshot& Snapshot, int32 OutputSize)
+{
+	if (Snapshot.Format == EBlueprintWireFormat::Json && !Snapshot.bPartial)
+	{
+		LastExportSize = OutputSize;
+	}
+
+	// Only full exports fill the fragment cache: partial ones skip nodes and may project fields away
+	if (Snapshot.bPartial)
+	{
+		LogExport(Snapshot, OutputSize);
+		return;
+	}
+
+	for (const FBlueprintExportSnapshot::FNode& Node : Snapshot.Nodes)
+	{
+		if (!Node.Data.IsSet())
+		{
+			continue;
+		}
+
+		// Skip nodes that were re-captured for a newer state while this snapshot was encoding
+		FNodeFragment* Fragment = Fragments.Find(Node.Id);
+		if (!Fragment || Fragment->Generation != Node.Generation)
+		{
+			continue;
+		}
+
+		if (Snapshot.Format == EBlueprintWireFormat::CompactBinary)
+		{
+			Fragment->CompactBinary = Node.CompactBinary;
+		}
+		else
+		{
+			Fragment->Json = Node.Json;
+		}
+	}
+
+	LogExport(Snapshot, OutputSize);
+}
+
+TArray<uint8> FBlueprintSerializer::Encode(FBlueprintExportSnapshot& Snapshot)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<uint8> Output;
+	if (Snapshot.Format == EBlueprintWireFormat::CompactBinary)
+	{
+		FBlueprintCbWriter Writer;
+		WriteBlueprint(Writer, Snapshot);
+		Output = Writer.Save();
+	}
+	else
+	{
+		Output.Reserve(Snapshot.SizeHint);
+		FMemoryWriter Archive(Output);
+		FSplicingJsonWriter Writer(&Archive);
+		WriteBlueprint(Writer, Snapshot);
+		Writer.Close();
+	}
+
+	Snapshot.EncodeSeconds = FPlatformTime::Seconds() - StartTime;
+	return Output;
+}
+
+void FBlueprintSerializer::LogExport(const FBlueprintExportSnapshot& Snapshot, int32 OutputSize)
+{
+	UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Serialized %s as %s (%d nodes, %d re-encoded, %d connections, %d bytes): capture %.2f ms on game thread, encode %.2f ms"),
+		*Snapshot.Name, Snapshot.Format == EBlueprintWireFormat::CompactBinary ? TEXT("compact binary") : TEXT("JSON"),
+		Snapshot.Nodes.Num(), Snapshot.CapturedNodeCount, Snapshot.Connections.Num(), OutputSize,
+		Snapshot.CaptureSeconds * 1000.0, Snapshot.EncodeSeconds * 1000.0);
+}
+
+template <typename WriterType>
+void FBlueprintSerializer::WriteBlueprint(WriterType& Writer, FBlueprintExportSnapshot& Snapshot)
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("name"), Snapshot.Name);
+	if (Snapshot.bPartial)
+	{
+		Writer.WriteValue(TEXT("partial"), true);
+	}
+
+	// Serialize nodes
+	Writer.WriteArrayStart(TEXT("nodes"));
+	for (FBlueprintExportSnapshot::FNode& Node : Snapshot.Nodes)
+	{
+		WriteNode(Writer, Node, Snapshot.Fields);
+	}
+	Writer.WriteArrayEnd();
+
+	// Serialize connections
+	if (EnumHasAnyFlags(Snapshot.Fields, EBlueprintExportFields::Connections))
+	{
+		Writer.WriteArrayStart(TEXT("connections"));
+		for (const FBlueprintConnectionData& Connection : Snapshot.Connections)
+		{
+			WriteConnection(Writer, Connection);
 		}
+		Writer.WriteArrayEnd();
+	}
+
+	// Comments as empty array for now
+	Writer.WriteArrayStart(TEXT("comments"));
+	Writer.WriteArrayEnd();
+
+	// Serialize variables
+	if (EnumHasAnyFlags(Snapshot.Fields, EBlueprintExportFields::Variables))
+	{
+		Writer.WriteArrayStart(TEXT("variables"));
+		for (const FBlueprintVariableData& Variable : Snapshot.Variables)
+		{
+			WriteVariable(Writer, Variable);
+		}
+		Writer.WriteArrayEnd();
+	}
+
+	Writer.WriteObjectEnd();
+}
+
+void FBlueprintSerializer::WriteNode(FSplicingJsonWriter& Writer, FBlueprintExportSnapshot::FNode& Node, EBlueprintExportFields Fields)
+{
+	if (!Node.Json.IsValid())
+	{
+		// Encoded straight to UTF-8, so a cached fragment is copied into later exports without transcoding
+		TArray<uint8> Json;
+		FMemoryWriter Archive(Json);
+		TSharedRef<FUtf8JsonWriter> FragmentWriter = FUtf8JsonWriter::Create(&Archive);
+		WriteNodeBody(*FragmentWriter, Node.Data.GetValue(), Fields);
+		FragmentWriter->Close();
+		Node.Json = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Json));
+	}
+	Writer.WriteRawUtf8Value(*Node.Json);
+}
+
+void FBlueprintSerializer::FSplicingJsonWriter::WriteRawUtf8Value(TConstArrayView<uint8> Json)
+{
+	// Same separator rule as any other array element, then the bytes themselves
+	WriteCommaIfNeeded();
+	Stream->Serialize(const_cast<uint8*>(Json.GetData()), Json.Num());
+	PreviousTokenWritten = EJsonToken::CurlyClose;
+}
+
+void FBlueprintSerializer::WriteNode(FBlueprintCbWriter& Writer, FBlueprintExportSnapshot::FNode& Node, EBlueprintExportFields Fields)
+{
+	if (!Node.CompactBinary.IsSet())
+	{
+		FBlueprintCbWriter FragmentWriter;
+		WriteNodeBody(FragmentWriter, Node.Data.GetValue(), Fields);
+		Node.CompactBinary = FragmentWriter.SaveObject();
 	}
+	Writer.WriteObject(Node.CompactBinary.GetValue());
+}
 
-	NodeJson->SetArrayField(TEXT("inputPins"), InputPins);
-	NodeJson->SetArrayField(TEXT("outputPins"), OutputPins);
+template <typename WriterType>
+void FBlueprintSerializer::WriteNodeBody(WriterType& Writer, const FBlueprintNodeData& Node, EBlueprintExportFields Fields)
+{
+	Writer.WriteObjectStart();
+	WriteId(Writer, TEXT("id"), Node.Id);
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Title))
+	{
+		Writer.WriteValue(TEXT("title"), Node.Title);
+	}
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Category))
+	{
+		Writer.WriteValue(TEXT("category"), Node.Category);
+	}
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Style))
+	{
+		Writer.WriteValue(TEXT("style"), Node.Style);
+	}
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Position))
+	{
+		Writer.WriteValue(TEXT("positionX"), Node.PosX);
+		Writer.WriteValue(TEXT("positionY"), Node.PosY);
+	}
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Style))
+	{
+		Writer.WriteValue(TEXT("isCompact"), Node.bIsCompact);
+	}
+
+	// Serialize pins
+	if (EnumHasAnyFlags(Fields, EBlueprintExportFields::Pins))
+	{
+		Writer.WriteArrayStart(TEXT("inputPins"));
+		for (const FBlueprintPinData& Pin : Node.InputPins)
+		{
+			WritePin(Writer, Pin, TEXT("Input"));
+		}
+		Writer.WriteArrayEnd();
 
-	return NodeJson;
+		Writer.WriteArrayStart(TEXT("outputPins"));
+		for (const FBlueprintPinData& Pin : Node.OutputPins)
+		{
+			WritePin(Writer, Pin, TEXT("Output"));
+		}
+		Writer.WriteArrayEnd();
+	}
+
+	Writer.WriteObjectEnd();
 }
 
-TSharedPtr<FJsonObject> FBlueprintSerializer::SerializePin(UEdGraphPin* Pin)
+template <typename WriterType>
+void FBlueprintSerializer::WritePin(WriterType& Writer, const FBlueprintPinData& Pin, const TCHAR* Direction)
 {
-	TSharedPtr<FJsonObject> PinJson = MakeShared<FJsonObject>();
+	Writer.WriteObjectStart();
+	WriteId(Writer, TEXT("id"), Pin.Id);
+	Writer.WriteValue(TEXT("name"), Pin.Name);
+	Writer.WriteValue(TEXT("type"), Pin.Type);
+	Writer.WriteValue(TEXT("direction"), Direction);
+	Writer.WriteValue(TEXT("isConnected"), Pin.bIsConnected);
+
+	if (Pin.bHasDefaultValue)
+	{
+		Writer.WriteValue(TEXT("defaultValue"), Pin.DefaultValue);
+	}
 
-	FString PinId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
-	PinMap.Add(PinId, Pin);
+	if (!Pin.SubType.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("subType"), Pin.SubType);
+	}
 
-	PinJson->SetStringField(TEXT("id"), PinId);
-	PinJson->SetStringField(TEXT("name"), Pin->GetDisplayName().ToString());
-	PinJson->SetStringField(TEXT("type"), MapPinType(Pin));
-	PinJson->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
-	PinJson->SetBoolField(TEXT("isConnected"), Pin->LinkedTo.Num() > 0);
+	Writer.WriteObjectEnd();
+}
 
-	if (!Pin->DefaultValue.IsEmpty())
+uint32 FBlueprintSerializer::ComputeFingerprint(const UK2Node* Node)
+{
+	// Everything the fragment shows that can change without the node being Modify()'d (e.g. links made by MakeLinkTo)
+	uint32 Hash = HashCombine(GetTypeHash(Node->NodePosX), GetTypeHash(Node->NodePosY));
+	for (const UEdGraphPin* Pin : Node->Pins)
 	{
-		PinJson->SetStringField(TEXT("defaultValue"), Pin->DefaultValue);
+		Hash = HashCombine(Hash, GetTypeHash(Pin->PinId));
+		Hash = HashCombine(Hash, GetTypeHash(Pin->LinkedTo.Num()));
+		Hash = HashCombine(Hash, GetTypeHash(Pin->bHidden));
+		Hash = HashCombine(Hash, FCrc::StrCrc32(*Pin->DefaultValue));
 	}
+	return Hash;
+}
 
-	// SubType for struct/object pins
-	if (Pin->PinType.PinSubCategoryObject.IsValid())
+void FBlueprintSerializer::OnObjectModified(UObject* Object)
+{
+	UBlueprint* Blueprint = ExportedBlueprint.Get();
+	if (!Blueprint || Object->GetOutermost() != Blueprint->GetOutermost())
 	{
-		PinJson->SetStringField(TEXT("subType"), Pin->PinType.PinSubCategoryObject->GetName());
+		return;
 	}
 
-	return PinJson;
+	if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		DirtyNodes.Add(Node);
+	}
+	else if (Object == Blueprint)
+	{
+		// Renames and other blueprint-wide edits can change any node's title
+		Fragments.Empty();
+	}
 }
 
-TArray<TSharedPtr<FJsonValue>> FBlueprintSerializer::SerializeConnections(UEdGraph* Graph)
+void FBlueprintSerializer::CaptureConnections(const TArray<UK2Node*>& Nodes, TArray<FBlueprintConnectionData>& OutConnections) const
 {
-	TArray<TSharedPtr<FJsonValue>> Connections;
-	TSet<FString> ProcessedConnections;
+	TSet<TPair<const UEdGraphPin*, const UEdGraphPin*>> ProcessedConnections;
 
-	for (UEdGraphNode* Node : Graph->Nodes)
+	// Links to nodes outside the export are not registered, so they drop out below
+	for (UK2Node* Node : Nodes)
 	{
+		const FString* SourceNodeId = Registry.FindNodeId(Node);
+		if (!SourceNodeId)
+		{
+			continue;
+		}
+
 		for (UEdGraphPin* Pin : Node->Pins)
 		{
 			if (Pin->Direction != EGPD_Output)
@@ -160,56 +648,55 @@ TArray<TSharedPtr<FJsonValue>> FBlueprintSerializer::SerializeConnections(UEdGra
 				continue;
 			}
 
-			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			const FString* SourcePinId = Registry.FindPinId(Pin);
+			if (!SourcePinId)
 			{
-				// Find IDs from our maps
-				FString SourcePinId;
-				FString TargetPinId;
-				FString SourceNodeId;
-				FString TargetNodeId;
-
-				for (const auto& Pair : PinMap)
-				{
-					if (Pair.Value == Pin) SourcePinId = Pair.Key;
-					if (Pair.Value == LinkedPin) TargetPinId = Pair.Key;
-				}
-
-				for (const auto& Pair : NodeMap)
-				{
-					if (Pair.Value == Node) SourceNodeId = Pair.Key;
-					if (Pair.Value == LinkedPin->GetOwningNode()) TargetNodeId = Pair.Key;
-				}
+				continue;
+			}
 
-				if (SourcePinId.IsEmpty() || TargetPinId.IsEmpty())
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const FString* TargetPinId = Registry.FindPinId(LinkedPin);
+				const FString* TargetNodeId = Registry.FindNodeId(LinkedPin->GetOwningNode());
+				if (!TargetPinId || !TargetNodeId)
 				{
 					continue;
 				}
 
 				// Deduplicate
-				FString ConnectionKey = SourcePinId + TEXT("->") + TargetPinId;
-				if (ProcessedConnections.Contains(ConnectionKey))
+				bool bAlreadyProcessed = false;
+				ProcessedConnections.Add(TPair<const UEdGraphPin*, const UEdGraphPin*>(Pin, LinkedPin), &bAlreadyProcessed);
+				if (bAlreadyProcessed)
 				{
 					continue;
 				}
-				ProcessedConnections.Add(ConnectionKey);
 
-				TSharedPtr<FJsonObject> ConnJson = MakeShared<FJsonObject>();
-				ConnJson->SetStringField(TEXT("id"), FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
-				ConnJson->SetStringField(TEXT("sourceNodeId"), SourceNodeId);
-				ConnJson->SetStringField(TEXT("sourcePinId"), SourcePinId);
-				ConnJson->SetStringField(TEXT("targetNodeId"), TargetNodeId);
-				ConnJson->SetStringField(TEXT("targetPinId"), TargetPinId);
-				ConnJson->SetStringField(TEXT("pinType"), MapPinType(Pin));
-
-				Connections.Add(MakeShared<FJsonValueObject>(ConnJson));
+				FBlueprintConnectionData& Connection = OutConnections.AddDefaulted_GetRef();
+				Connection.Id = FBlueprintIdRegistry::MakeConnectionId(Pin, LinkedPin);
+				Connection.SourceNodeId = *SourceNodeId;
+				Connection.SourcePinId = *SourcePinId;
+				Connection.TargetNodeId = *TargetNodeId;
+				Connection.TargetPinId = *TargetPinId;
+				Connection.PinType = MapPinType(Pin);
 			}
 		}
 	}
+}
 
-	return Connections;
+template <typename WriterType>
+void FBlueprintSerializer::WriteConnection(WriterType& Writer, const FBlueprintConnectionData& Connection)
+{
+	Writer.WriteObjectStart();
+	WriteId(Writer, TEXT("id"), Connection.Id);
+	WriteId(Writer, TEXT("sourceNodeId"), Connection.SourceNodeId);
+	WriteId(Writer, TEXT("sourcePinId"), Connection.SourcePinId);
+	WriteId(Writer, TEXT("targetNodeId"), Connection.TargetNodeId);
+	WriteId(Writer, TEXT("targetPinId"), Connection.TargetPinId);
+	Writer.WriteValue(TEXT("pinType"), Connection.PinType);
+	Writer.WriteObjectEnd();
 }
 
-FString FBlueprintSerializer::MapNodeStyle(UK2Node* Node) const
+FString FBlueprintSerializer::MapNodeStyle(UK2Node* Node)
 {
 	if (Cast<UK2Node_Event>(Node) || Cast<UK2Node_CustomEvent>(Node))
 	{
@@ -277,7 +764,7 @@ FString FBlueprintSerializer::MapPinType(UEdGraphPin* Pin) const
 	return TEXT("Wildcard");
 }
 
-FString FBlueprintSerializer::MapPinTypeFromPinType(const FEdGraphPinType& PinType) const
+FString FBlueprintSerializer::MapPinTypeFromPinType(const FEdGraphPinType& PinType)
 {
 	const FName& Category = PinType.PinCategory;
 
@@ -306,34 +793,53 @@ FString FBlueprintSerializer::MapPinTypeFromPinType(const FEdGraphPinType& PinTy
 	return TEXT("Wildcard");
 }
 
-TArray<TSharedPtr<FJsonValue>> FBlueprintSerializer::SerializeVariables(UBlueprint* Blueprint)
+void FBlueprintSerializer::CaptureVariables(UBlueprint* Blueprint, TArray<FBlueprintVariableData>& OutVariables)
 {
-	TArray<TSharedPtr<FJsonValue>> VariablesArray;
-
+	OutVariables.Reserve(Blueprint->NewVariables.Num());
 	for (const FBPVariableDescription& VarDesc : Blueprint->NewVariables)
 	{
-		TSharedPtr<FJsonObject> VarJson = MakeShared<FJsonObject>();
-
-		VarJson->SetStringField(TEXT("id"), FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
-		VarJson->SetStringField(TEXT("name"), VarDesc.VarName.ToString());
-		VarJson->SetStringField(TEXT("type"), MapPinTypeFromPinType(VarDesc.VarType));
-
-		if (!VarDesc.DefaultValue.IsEmpty())
-		{
-			VarJson->SetStringField(TEXT("defaultValue"), VarDesc.DefaultValue);
-		}
+		FBlueprintVariableData& Variable = OutVariables.AddDefaulted_GetRef();
+		Variable.Id = FBlueprintIdRegistry::MakeVariableId(VarDesc);
+		Variable.Name = VarDesc.VarName.ToString();
+		Variable.Type = MapPinTypeFromPinType(VarDesc.VarType);
+		Variable.DefaultValue = VarDesc.DefaultValue;
+		Variable.Category = VarDesc.Category.ToString();
+		// "Instance Editable" in the details panel; the deserializer sets and clears the same flags
+		Variable.bIsEditable = (VarDesc.PropertyFlags & CPF_Edit) != 0 && (VarDesc.PropertyFlags & CPF_DisableEditOnInstance) == 0;
+	}
+}
 
-		VarJson->SetStringField(TEXT("category"), VarDesc.Category.ToString());
-		VarJson->SetBoolField(TEXT("isEditable"), (VarDesc.PropertyFlags & (CPF_Edit | CPF_BlueprintVisible)) != 0);
+template <typename WriterType>
+void FBlueprintSerializer::WriteVariable(WriterType& Writer, const FBlueprintVariableData& Variable)
+{
+	Writer.WriteObjectStart();
+	WriteId(Writer, TEXT("id"), Variable.Id);
+	Writer.WriteValue(TEXT("name"), Variable.Name);
+	Writer.WriteValue(TEXT("type"), Variable.Type);
 
-		VariablesArray.Add(MakeShared<FJsonValueObject>(VarJson));
+	if (!Variable.DefaultValue.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("defaultValue"), Variable.DefaultValue);
 	}
 
-	return VariablesArray;
+	Writer.WriteValue(TEXT("category"), Variable.Category);
+	Writer.WriteValue(TEXT("isEditable"), Variable.bIsEditable);
+	Writer.WriteObjectEnd();
 }
 
 void FBlueprintSerializer::ClearMappings()
 {
-	NodeMap.Empty();
-	PinMap.Empty();
+	Registry.Reset();
+	Fragments.Empty();
+}
+
+template <typename CharType, typename PrintPolicy>
+void FBlueprintSerializer::WriteId(TJsonWriter<CharType, PrintPolicy>& Writer, const TCHAR* Key, const FString& Id)
+{
+	Writer.WriteValue(Key, Id);
+}
+
+void FBlueprintSerializer::WriteId(FBlueprintCbWriter& Writer, const TCHAR* Key, const FString& Id)
+{
+	Writer.WriteId(Key, Id);
 }
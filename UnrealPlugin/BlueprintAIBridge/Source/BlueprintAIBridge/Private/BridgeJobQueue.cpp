@@ -0,0 +1,150 @@
+#include "BridgeJobQueue.h"
+#include "Dom/JsonObject.h"
+
+FBridgeJobQueue::FBridgeJobQueue()
+{
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBridgeJobQueue::Tick), 0.02f);
+}
+
+FBridgeJobQueue::~FBridgeJobQueue()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+}
+
+TSharedRef<FBridgeJob> FBridgeJobQueue::Submit(const FString& Kind, const FString& Target, TFunction<bool(FBridgeJob&)>&& Start)
+{
+	TSharedRef<FBridgeJob> Job = MakeShared<FBridgeJob>();
+	Job->Id = FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+	Job->Kind = Kind;
+	Job->Target = Target;
+	Job->Phase = TEXT("queued");
+	Job->QueuedTime = FPlatformTime::Seconds();
+	Job->Start = MoveTemp(Start);
+
+	Jobs.Add(Job->Id, Job);
+	Queued.Add(Job);
+	return Job;
+}
+
+TSharedPtr<FBridgeJob> FBridgeJobQueue::Find(const FString& Id) const
+{
+	const TSharedRef<FBridgeJob>* Job = Jobs.Find(Id);
+	return Job ? TSharedPtr<FBridgeJob>(*Job) : nullptr;
+}
+
+void FBridgeJobQueue::Finish(const FString& Id, bool bSuccess, const TSharedPtr<FJsonObject>& Result)
+{
+	TSharedRef<FBridgeJob>* Job = Jobs.Find(Id);
+	if (!Job || (*Job)->IsFinished())
+	{
+		return;
+	}
+
+	FBridgeJob& Finished = Job->Get();
+	Finished.State = bSuccess ? EBridgeJobState::Succeeded : EBridgeJobState::Failed;
+	Finished.Phase = TEXT("done");
+	Finished.FinishTime = FPlatformTime::Seconds();
+	Finished.Result = Result;
+	Finished.Start = nullptr;
+	Finished.Cancel = nullptr;
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Job %s (%s %s) %s after %.2f ms queued, %.2f ms running"),
+		*Finished.Id, *Finished.Kind, *Finished.Target, LexState(Finished.State),
+		(Finished.StartTime - Finished.QueuedTime) * 1000.0, (Finished.FinishTime - Finished.StartTime) * 1000.0);
+}
+
+bool FBridgeJobQueue::Cancel(FBridgeJob& Job)
+{
+	if (Job.State == EBridgeJobState::Queued)
+	{
+		Queued.RemoveAll([&Job](const TSharedRef<FBridgeJob>& Entry) { return &Entry.Get() == &Job; });
+	}
+	else if (Job.State != EBridgeJobState::Running || !Job.Cancel || !Job.Cancel())
+	{
+		return false;
+	}
+
+	Job.State = EBridgeJobState::Cancelled;
+	Job.Phase = TEXT("cancelled");
+	Job.FinishTime = FPlatformTime::Seconds();
+	Job.Start = nullptr;
+	Job.Cancel = nullptr;
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Job %s (%s %s) cancelled"), *Job.Id, *Job.Kind, *Job.Target);
+	return true;
+}
+
+bool FBridgeJobQueue::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Oldest first; a job that can't start yet holds back later jobs on the same target
+	TSet<FString> BlockedTargets;
+	for (int32 Index = 0; Index < Queued.Num();)
+	{
+		TSharedRef<FBridgeJob> Job = Queued[Index];
+		if (BlockedTargets.Contains(Job->Target))
+		{
+			Index++;
+			continue;
+		}
+
+		Job->State = EBridgeJobState::Running;
+		Job->StartTime = Now;
+		if (!Job->Start(*Job))
+		{
+			Job->State = EBridgeJobState::Queued;
+			Job->StartTime = 0.0;
+			BlockedTargets.Add(Job->Target);
+			Index++;
+			continue;
+		}
+		Queued.RemoveAt(Index);
+	}
+
+	Prune(Now);
+	return true;
+}
+
+void FBridgeJobQueue::Prune(double Now)
+{
+	TArray<const FBridgeJob*> Finished;
+	for (const TPair<FString, TSharedRef<FBridgeJob>>& Pair : Jobs)
+	{
+		if (Pair.Value->IsFinished())
+		{
+			Finished.Add(&Pair.Value.Get());
+		}
+	}
+	if (Finished.Num() == 0)
+	{
+		return;
+	}
+
+	// Past the cap, the jobs that finished first go first
+	Finished.Sort([](const FBridgeJob& A, const FBridgeJob& B) { return A.FinishTime < B.FinishTime; });
+	const int32 Excess = Finished.Num() - MaxRetainedJobs;
+	TArray<FString> Expired;
+	for (int32 Index = 0; Index < Finished.Num(); ++Index)
+	{
+		if (Index < Excess || Now - Finished[Index]->FinishTime > RetainSeconds)
+		{
+			Expired.Add(Finished[Index]->Id);
+		}
+	}
+	for (const FString& Id : Expired)
+	{
+		Jobs.Remove(Id);
+	}
+}
+
+const TCHAR* FBridgeJobQueue::LexState(EBridgeJobState State)
+{
+	switch (State)
+	{
+	case EBridgeJobState::Queued: return TEXT("queued");
+	case EBridgeJobState::Running: return TEXT("running");
+	case EBridgeJobState::Succeeded: return TEXT("succeeded");
+	case EBridgeJobState::Failed: return TEXT("failed");
+	default: return TEXT("cancelled");
+	}
+}
@@ -0,0 +1,419 @@
+#include "BridgeWebSocketServer.h"
+#include "BlueprintChangeFeed.h"
+#include "HttpServerHandler.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "INetworkingWebSocket.h"
+#include "IWebSocketNetworkingModule.h"
+#include "IWebSocketServer.h"
+#include "WebSocketNetworkingDelegates.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Engine/Blueprint.h"
+
+typedef TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> FEnvelopeWriter;
+typedef TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> FEnvelopeWriterFactory;
+
+struct FBridgeWebSocketServer::FEnvelope
+{
+	FString Id;
+	FString Op;
+	TMap<FString, FString> Params;
+	TMap<FString, TArray<FString>> Headers;
+};
+
+FBridgeWebSocketServer::FBridgeWebSocketServer(FHttpServerHandler& InHandler)
+	: Handler(InHandler)
+{
+}
+
+FBridgeWebSocketServer::~FBridgeWebSocketServer()
+{
+	Stop();
+}
+
+bool FBridgeWebSocketServer::Start(uint32 Port)
+{
+	IWebSocketNetworkingModule& WebSocketModule = FModuleManager::LoadModuleChecked<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking"));
+	Server = WebSocketModule.CreateServer();
+
+	FWebSocketClientConnectedCallBack OnConnected;
+	OnConnected.BindRaw(this, &FBridgeWebSocketServer::OnClientConnected);
+	if (!Server.IsValid() || !Server->Init(Port, OnConnected))
+	{
+		UE_LOG(LogTemp, Error, TEXT("BlueprintAIBridge: Failed to start WebSocket server on port %d"), Port);
+		Server.Reset();
+		return false;
+	}
+
+	// The socket server only does work when ticked; a zero delay ticks it every frame
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBridgeWebSocketServer::Tick), 0.0f);
+	ChangeEventHandle = Handler.GetChangeFeed().OnChangeEvent().AddRaw(this, &FBridgeWebSocketServer::OnChangeEvent);
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: WebSocket server started on port %d"), Port);
+	return true;
+}
+
+void FBridgeWebSocketServer::Stop()
+{
+	if (!Server.IsValid())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	Handler.GetChangeFeed().OnChangeEvent().Remove(ChangeEventHandle);
+
+	for (TPair<uint32, FConnection>& Pair : Connections)
+	{
+		ReleaseSubscriptions(Pair.Value);
+	}
+	Connections.Empty();
+	Server.Reset();
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: WebSocket server shut down"));
+}
+
+void FBridgeWebSocketServer::OnClientConnected(INetworkingWebSocket* Socket)
+{
+	const uint32 ConnectionId = NextConnectionId++;
+	Socket->SetReceiveCallBack(FWebSocketPacketReceivedCallBack::CreateRaw(this, &FBridgeWebSocketServer::OnMessage, ConnectionId));
+	Socket->SetSocketClosedCallBack(FWebSocketInfoCallBack::CreateRaw(this, &FBridgeWebSocketServer::OnClosed, ConnectionId));
+
+	FConnection& Connection = Connections.Add(ConnectionId);
+	Connection.Socket.Reset(Socket);
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: WebSocket client %u connected"), ConnectionId);
+}
+
+void FBridgeWebSocketServer::OnClosed(uint32 ConnectionId)
+{
+	// The socket is still inside its own callback here; Tick deletes it
+	if (FConnection* Connection = Connections.Find(ConnectionId))
+	{
+		Connection->bClosed = true;
+		ReleaseSubscriptions(*Connection);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: WebSocket client %u disconnected"), ConnectionId);
+}
+
+bool FBridgeWebSocketServer::Tick(float DeltaTime)
+{
+	Server->Tick();
+
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		if (It.Value().bClosed)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	return true;
+}
+
+void FBridgeWebSocketServer::OnMessage(void* Data, int32 Size, uint32 ConnectionId)
+{
+	const uint8* Bytes = static_cast<const uint8*>(Data);
+	int32 EnvelopeSize = 0;
+	while (EnvelopeSize < Size && Bytes[EnvelopeSize] != '\n')
+	{
+		++EnvelopeSize;
+	}
+
+	// The envelope is a few hundred bytes at most; only the payload is worth keeping in UTF-8
+	FUTF8ToTCHAR EnvelopeConverter(reinterpret_cast<const ANSICHAR*>(Bytes), EnvelopeSize);
+	const FString EnvelopeText(EnvelopeConverter.Length(), EnvelopeConverter.Get());
+
+	TSharedPtr<FJsonObject> Json;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(EnvelopeText);
+	if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+	{
+		SendError(ConnectionId, FString(), 400, TEXT("Malformed message envelope"));
+		return;
+	}
+
+	FEnvelope Request;
+	if (!Json->TryGetStringField(TEXT("id"), Request.Id))
+	{
+		double NumericId = 0.0;
+		if (Json->TryGetNumberField(TEXT("id"), NumericId))
+		{
+			Request.Id = FString::Printf(TEXT("%lld"), static_cast<int64>(NumericId));
+		}
+	}
+	Json->TryGetStringField(TEXT("op"), Request.Op);
+
+	const TSharedPtr<FJsonObject>* Params = nullptr;
+	if (Json->TryGetObjectField(TEXT("params"), Params))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Params)->Values)
+		{
+			FString Value;
+			if (Pair.Value->TryGetString(Value))
+			{
+				Request.Params.Add(Pair.Key, Value);
+			}
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* Headers = nullptr;
+	if (Json->TryGetObjectField(TEXT("headers"), Headers))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Headers)->Values)
+		{
+			FString Value;
+			if (Pair.Value->TryGetString(Value))
+			{
+				Request.Headers.Add(Pair.Key, TArray<FString>{ Value });
+			}
+		}
+	}
+
+	TArray<uint8> Payload;
+	if (EnvelopeSize + 1 < Size)
+	{
+		Payload.Append(Bytes + EnvelopeSize + 1, Size - EnvelopeSize - 1);
+	}
+
+	Dispatch(ConnectionId, MoveTemp(Request), MoveTemp(Payload));
+}
+
+void FBridgeWebSocketServer::Dispatch(uint32 ConnectionId, FEnvelope&& Envelope, TArray<uint8>&& Payload)
+{
+	if (Envelope.Op == TEXT("subscribe") || Envelope.Op == TEXT("unsubscribe"))
+	{
+		SetSubscribed(ConnectionId, Envelope.Id, Envelope.Params.FindRef(TEXT("name")), Envelope.Op == TEXT("subscribe"));
+		return;
+	}
+
+	typedef bool (FHttpServerHandler::*FRouteFunc)(const FHttpServerRequest&, const FHttpResultCallback&);
+	FRouteFunc Route = nullptr;
+	EHttpServerRequestVerbs Verb = EHttpServerRequestVerbs::VERB_GET;
+	const TCHAR* Path = nullptr;
+
+	if (Envelope.Op == TEXT("status"))
+	{
+		Route = &FHttpServerHandler::HandleStatus;
+		Path = TEXT("/api/status");
+	}
+	else if (Envelope.Op == TEXT("list"))
+	{
+		Route = &FHttpServerHandler::HandleListBlueprints;
+		Path = TEXT("/api/blueprints");
+	}
+	else if (Envelope.Op == TEXT("get"))
+	{
+		Route = &FHttpServerHandler::HandleGetBlueprint;
+		Path = TEXT("/api/blueprint");
+	}
+	else if (Envelope.Op == TEXT("apply"))
+	{
+		Route = &FHttpServerHandler::HandleApplyBlueprint;
+		Verb = EHttpServerRequestVerbs::VERB_POST;
+		Path = TEXT("/api/blueprint/apply");
+	}
+	else if (Envelope.Op == TEXT("create"))
+	{
+		Route = &FHttpServerHandler::HandleCreateBlueprint;
+		Verb = EHttpServerRequestVerbs::VERB_POST;
+		Path = TEXT("/api/blueprint/create");
+	}
+
+	if (!Route)
+	{
+		SendError(ConnectionId, Envelope.Id, 400, FString::Printf(TEXT("Unknown op '%s'"), *Envelope.Op));
+		return;
+	}
+
+	FHttpServerRequest Request;
+	Request.Verb = Verb;
+	Request.RelativePath = FHttpPath(Path);
+	Request.QueryParams = MoveTemp(Envelope.Params);
+	Request.Headers = MoveTemp(Envelope.Headers);
+	Request.Body = MoveTemp(Payload);
+
+	// Handlers may complete later (compression, held requests), after this server or the client is gone
+	TWeakPtr<FBridgeWebSocketServer> WeakThis = AsShared();
+	const double StartTime = FPlatformTime::Seconds();
+	FHttpResultCallback OnComplete = [WeakThis, ConnectionId, RequestId = Envelope.Id, Op = Envelope.Op, StartTime](TUniquePtr<FHttpServerResponse>&& Response)
+	{
+		TSharedPtr<FBridgeWebSocketServer> This = WeakThis.Pin();
+		if (!This.IsValid() || !Response.IsValid())
+		{
+			return;
+		}
+
+		const double ServerMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		// Response headers the client needs, under the envelope's field names
+		static const TPair<const TCHAR*, const TCHAR*> ForwardedHeaders[] =
+		{
+			{ TEXT("Content-Type"), TEXT("contentType") },
+			{ TEXT("Content-Encoding"), TEXT("contentEncoding") },
+			{ TEXT("ETag"), TEXT("etag") },
+		};
+
+		FString ResponseEnvelope;
+		TSharedRef<FEnvelopeWriter> Writer = FEnvelopeWriterFactory::Create(&ResponseEnvelope);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("id"), RequestId);
+		Writer->WriteValue(TEXT("status"), static_cast<int32>(Response->Code));
+		for (const TPair<const TCHAR*, const TCHAR*>& Header : ForwardedHeaders)
+		{
+			const TArray<FString>* Values = Response->Headers.Find(Header.Key);
+			if (Values && Values->Num() > 0)
+			{
+				Writer->WriteValue(Header.Value, (*Values)[0]);
+			}
+		}
+		Writer->WriteValue(TEXT("serverMs"), ServerMs);
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		This->SendFrame(ConnectionId, ResponseEnvelope, Response->Body);
+
+		UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: WebSocket %s #%s answered in %.2f ms (%d bytes)"),
+			*Op, *RequestId, ServerMs, Response->Body.Num());
+	};
+
+	(Handler.*Route)(Request, OnComplete);
+}
+
+void FBridgeWebSocketServer::SetSubscribed(uint32 ConnectionId, const FString& RequestId, const FString& BlueprintName, bool bSubscribe)
+{
+	FConnection* Connection = Connections.Find(ConnectionId);
+	if (!Connection)
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = Handler.FindBlueprintByName(BlueprintName);
+	if (!Blueprint && bSubscribe)
+	{
+		// Answer once the blueprint has streamed in; the connection may have gone by then
+		TWeakPtr<FBridgeWebSocketServer> WeakThis = AsShared();
+		if (Handler.LoadBlueprintsAsync({ BlueprintName }, [WeakThis, ConnectionId, RequestId, BlueprintName]()
+			{
+				if (TSharedPtr<FBridgeWebSocketServer> This = WeakThis.Pin())
+				{
+					This->SetSubscribed(ConnectionId, RequestId, BlueprintName, true);
+				}
+			}))
+		{
+			return;
+		}
+	}
+	if (!Blueprint)
+	{
+		SendError(ConnectionId, RequestId, 404, FString::Printf(TEXT("Blueprint '%s' not found"), *BlueprintName));
+		return;
+	}
+
+	if (bSubscribe)
+	{
+		bool bAlreadySubscribed = false;
+		Connection->Subscriptions.Add(Blueprint, &bAlreadySubscribed);
+		if (!bAlreadySubscribed)
+		{
+			Handler.GetChangeFeed().Watch(Blueprint);
+		}
+	}
+	else if (Connection->Subscriptions.Remove(Blueprint) > 0)
+	{
+		Handler.GetChangeFeed().Unwatch(Blueprint);
+	}
+
+	FString Envelope;
+	TSharedRef<FEnvelopeWriter> Writer = FEnvelopeWriterFactory::Create(&Envelope);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("id"), RequestId);
+	Writer->WriteValue(TEXT("status"), 200);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	SendFrame(ConnectionId, Envelope, TConstArrayView<uint8>());
+}
+
+void FBridgeWebSocketServer::OnChangeEvent(UBlueprint* Blueprint, uint64 EventId, const TCHAR* Name, const FString& Data)
+{
+	FString Envelope;
+	TArray<uint8> Payload;
+
+	for (const TPair<uint32, FConnection>& Pair : Connections)
+	{
+		if (Pair.Value.bClosed || !Pair.Value.Subscriptions.Contains(Blueprint))
+		{
+			continue;
+		}
+
+		// Encode once, on the first subscriber
+		if (Envelope.IsEmpty())
+		{
+			TSharedRef<FEnvelopeWriter> Writer = FEnvelopeWriterFactory::Create(&Envelope);
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("event"), Name);
+			Writer->WriteValue(TEXT("blueprint"), Blueprint->GetName());
+			Writer->WriteValue(TEXT("eventId"), static_cast<int64>(EventId));
+			Writer->WriteObjectEnd();
+			Writer->Close();
+			FTCHARToUTF8 DataUtf8(*Data);
+			Payload.Append(reinterpret_cast<const uint8*>(DataUtf8.Get()), DataUtf8.Length());
+		}
+
+		SendFrame(Pair.Key, Envelope, Payload);
+	}
+}
+
+void FBridgeWebSocketServer::ReleaseSubscriptions(FConnection& Connection)
+{
+	for (const TWeakObjectPtr<UBlueprint>& Subscription : Connection.Subscriptions)
+	{
+		if (UBlueprint* Blueprint = Subscription.Get())
+		{
+			Handler.GetChangeFeed().Unwatch(Blueprint);
+		}
+	}
+	Connection.Subscriptions.Empty();
+}
+
+void FBridgeWebSocketServer::SendFrame(uint32 ConnectionId, const FString& Envelope, TConstArrayView<uint8> Payload)
+{
+	FConnection* Connection = Connections.Find(ConnectionId);
+	if (!Connection || Connection->bClosed)
+	{
+		return;
+	}
+
+	FTCHARToUTF8 EnvelopeUtf8(*Envelope);
+	TArray<uint8> Frame;
+	Frame.Reserve(EnvelopeUtf8.Length() + 1 + Payload.Num());
+	Frame.Append(reinterpret_cast<const uint8*>(EnvelopeUtf8.Get()), EnvelopeUtf8.Length());
+	Frame.Add('\n');
+	Frame.Append(Payload.GetData(), Payload.Num());
+
+	Connection->Socket->Send(Frame.GetData(), Frame.Num(), false);
+}
+
+void FBridgeWebSocketServer::SendError(uint32 ConnectionId, const FString& RequestId, int32 Status, const FString& Message)
+{
+	FString Envelope;
+	TSharedRef<FEnvelopeWriter> EnvelopeWriter = FEnvelopeWriterFactory::Create(&Envelope);
+	EnvelopeWriter->WriteObjectStart();
+	EnvelopeWriter->WriteValue(TEXT("id"), RequestId);
+	EnvelopeWriter->WriteValue(TEXT("status"), Status);
+	EnvelopeWriter->WriteValue(TEXT("contentType"), TEXT("application/json"));
+	EnvelopeWriter->WriteObjectEnd();
+	EnvelopeWriter->Close();
+
+	FString Body;
+	TSharedRef<FEnvelopeWriter> BodyWriter = FEnvelopeWriterFactory::Create(&Body);
+	BodyWriter->WriteObjectStart();
+	BodyWriter->WriteValue(TEXT("error"), Message);
+	BodyWriter->WriteObjectEnd();
+	BodyWriter->Close();
+
+	FTCHARToUTF8 BodyUtf8(*Body);
+	SendFrame(ConnectionId, Envelope, TConstArrayView<uint8>(reinterpret_cast<const uint8*>(BodyUtf8.Get()), BodyUtf8.Length()));
+}
@@ -0,0 +1,109 @@
+#include "HttpCompression.h"
+#include "Misc/Compression.h"
+
+FName FHttpCompression::NegotiateEncoding(const FHttpServerRequest& Request)
+{
+	const TArray<FString>* Values = Request.Headers.Find(TEXT("Accept-Encoding"));
+	if (!Values)
+	{
+		return NAME_None;
+	}
+
+	bool bAcceptsGzip = false;
+	bool bAcceptsDeflate = false;
+	for (const FString& Value : *Values)
+	{
+		TArray<FString> Codings;
+		Value.ParseIntoArray(Codings, TEXT(","));
+		for (const FString& Coding : Codings)
+		{
+			FString Name = Coding;
+			FString Params;
+			Coding.Split(TEXT(";"), &Name, &Params);
+			Name.TrimStartAndEndInline();
+			Params.TrimStartAndEndInline();
+
+			// "gzip;q=0" explicitly refuses the coding
+			if (Params.StartsWith(TEXT("q=")) && FCString::Atof(*Params.Mid(2)) <= 0.0f)
+			{
+				continue;
+			}
+
+			bAcceptsGzip |= Name.Equals(TEXT("gzip"), ESearchCase::IgnoreCase) || Name == TEXT("*");
+			bAcceptsDeflate |= Name.Equals(TEXT("deflate"), ESearchCase::IgnoreCase);
+		}
+	}
+
+	if (bAcceptsGzip)
+	{
+		return NAME_Gzip;
+	}
+	return bAcceptsDeflate ? NAME_Zlib : NAME_None;
+}
+
+const TCHAR* FHttpCompression::GetEncodingName(FName Format)
+{
+	if (Format == NAME_Gzip) return TEXT("gzip");
+	if (Format == NAME_Zlib) return TEXT("deflate");
+	return TEXT("identity");
+}
+
+bool FHttpCompression::Compress(FName Format, TConstArrayView<uint8> Body, TArray<uint8>& OutCompressed)
+{
+	int32 CompressedSize = FCompression::CompressMemoryBound(Format, Body.Num());
+	OutCompressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(Format, OutCompressed.GetData(), CompressedSize, Body.GetData(), Body.Num(), COMPRESS_BiasSpeed))
+	{
+		OutCompressed.Reset();
+		return false;
+	}
+
+	OutCompressed.SetNum(CompressedSize);
+	return CompressedSize < Body.Num();
+}
+
+bool FHttpCompression::DecodeRequestBody(const FHttpServerRequest& Request, TArray<uint8>& Storage, TConstArrayView<uint8>& OutBody)
+{
+	OutBody = Request.Body;
+
+	const TArray<FString>* Values = Request.Headers.Find(TEXT("Content-Encoding"));
+	if (!Values || Values->Num() == 0)
+	{
+		return true;
+	}
+
+	const FString Encoding = (*Values)[0].TrimStartAndEnd();
+	if (Encoding.IsEmpty() || Encoding.Equals(TEXT("identity"), ESearchCase::IgnoreCase))
+	{
+		return true;
+	}
+	if (!Encoding.Equals(TEXT("gzip"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Unsupported request Content-Encoding '%s'"), *Encoding);
+		return false;
+	}
+
+	// The gzip trailer ends with the inflated size (mod 2^32), little-endian
+	const int32 CompressedSize = Request.Body.Num();
+	if (CompressedSize < 18)
+	{
+		return false;
+	}
+	const uint8* Trailer = Request.Body.GetData() + CompressedSize - 4;
+	const uint32 InflatedSize = Trailer[0] | (Trailer[1] << 8) | (Trailer[2] << 16) | (static_cast<uint32>(Trailer[3]) << 24);
+	if (InflatedSize > static_cast<uint32>(MaxInflatedBodySize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Rejected gzip request body inflating to %u bytes"), InflatedSize);
+		return false;
+	}
+
+	Storage.SetNumUninitialized(static_cast<int32>(InflatedSize));
+	if (!FCompression::UncompressMemory(NAME_Gzip, Storage.GetData(), Storage.Num(), Request.Body.GetData(), CompressedSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Failed to inflate gzip request body"));
+		return false;
+	}
+
+	OutBody = Storage;
+	return true;
+}
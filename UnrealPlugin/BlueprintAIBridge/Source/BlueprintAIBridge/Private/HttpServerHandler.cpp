@@ -7,6 +7,14 @@
 #include "Editor.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "BlueprintJsonReader.h"
+#include "BlueprintAssetCatalog.h"
+#include "BlueprintCbReader.h"
+#include "HttpCompression.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Find.h"
+#include "Serialization/MemoryWriter.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "AssetToolsModule.h"
 #include "Factories/BlueprintFactory.h"
@@ -18,37 +26,55 @@
 #include "GameFramework/GameModeBase.h"
 #include "Components/ActorComponent.h"
 
+/** Media type clients use to opt into Compact Binary for exports (Accept) and apply bodies (Content-Type) */
+static const TCHAR* CompactBinaryContentType = TEXT("application/x-ue-cb");
+
+FHttpServerHandler::FHttpServerHandler()
+	: Deserializer(Compiles)
+	, ChangeFeed(Revisions)
+{
+	// Free cached exports as soon as their blueprint changes, rather than on the next lookup
+	Revisions.OnRevisionChanged().AddRaw(this, &FHttpServerHandler::OnBlueprintRevisionChanged);
+}
+
 bool FHttpServerHandler::HandleStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("isConnected"), true);
 	Response->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
 
+	const FBlueprintExportCache::FStats CacheStats = ExportCache.GetStats();
+	TSharedPtr<FJsonObject> CacheJson = MakeShared<FJsonObject>();
+	CacheJson->SetNumberField(TEXT("hits"), CacheStats.Hits);
+	CacheJson->SetNumberField(TEXT("misses"), CacheStats.Misses);
+	CacheJson->SetNumberField(TEXT("evictions"), CacheStats.Evictions);
+	CacheJson->SetNumberField(TEXT("entries"), CacheStats.Entries);
+	CacheJson->SetNumberField(TEXT("bytes"), CacheStats.Bytes);
+	CacheJson->SetNumberField(TEXT("capacityBytes"), ExportCache.GetMaxBytes());
+	Response->SetObjectField(TEXT("exportCache"), CacheJson);
+
 	OnComplete(MakeJsonResponse(Response));
 	return true;
 }
 
 bool FHttpServerHandler::HandleListBlueprints(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
+	const FString* Scope = Request.QueryParams.Find(TEXT("scope"));
+	if (Scope && *Scope == TEXT("project"))
+	{
+		return HandleListProjectBlueprints(Request, OnComplete);
+	}
+
 	// FHttpServerModule dispatches handlers on the game thread in UE 5.x,
 	// so we can access editor subsystems directly — no marshaling needed.
 	TArray<TSharedPtr<FJsonValue>> BlueprintsList;
 
-	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-	if (AssetEditorSubsystem)
+	for (UBlueprint* Blueprint : Lookup.GetOpenBlueprints())
 	{
-		TArray<UObject*> EditedAssets = AssetEditorSubsystem->GetAllEditedAssets();
-		for (UObject* Asset : EditedAssets)
-		{
-			UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
-			if (Blueprint)
-			{
-				TSharedPtr<FJsonObject> BpInfo = MakeShared<FJsonObject>();
-				BpInfo->SetStringField(TEXT("name"), Blueprint->GetName());
-				BpInfo->SetStringField(TEXT("path"), Blueprint->GetPathName());
-				BlueprintsList.Add(MakeShared<FJsonValueObject>(BpInfo));
-			}
-		}
+		TSharedPtr<FJsonObject> BpInfo = MakeShared<FJsonObject>();
+		BpInfo->SetStringField(TEXT("name"), Blueprint->GetName());
+		BpInfo->SetStringField(TEXT("path"), Blueprint->GetPathName());
+		BlueprintsList.Add(MakeShared<FJsonValueObject>(BpInfo));
 	}
 
 	// Return as plain array for our backend's expected format
@@ -56,8 +82,76 @@ bool FHttpServerHandler::HandleListBlueprints(const FHttpServerRequest& Request,
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(BlueprintsList, Writer);
 
-	auto HttpResponse = FHttpServerResponse::Create(OutputString, TEXT("application/json"));
-	OnComplete(MoveTemp(HttpResponse));
+	FTCHARToUTF8 Utf8Output(*OutputString);
+	SendResponse(Request, OnComplete, TArray<uint8>(reinterpret_cast<const uint8*>(Utf8Output.Get()), Utf8Output.Length()), TEXT("application/json"));
+	return true;
+}
+
+bool FHttpServerHandler::HandleListProjectBlueprints(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	FBlueprintCatalogQuery Query;
+	Query.PathPrefix = Request.QueryParams.FindRef(TEXT("path"));
+	Query.ParentClass = Request.QueryParams.FindRef(TEXT("parentClass"));
+	Query.Cursor = Request.QueryParams.FindRef(TEXT("cursor"));
+	if (const FString* Limit = Request.QueryParams.Find(TEXT("limit")))
+	{
+		Query.Limit = FCString::Atoi(**Limit);
+	}
+	if (const FString* ModifiedSince = Request.QueryParams.Find(TEXT("modifiedSince")))
+	{
+		// ISO 8601 ("2024-05-01T12:00:00Z") or Unix seconds
+		FDateTime Since;
+		if (FDateTime::ParseIso8601(**ModifiedSince, Since))
+		{
+			Query.ModifiedSince = Since;
+		}
+		else if (ModifiedSince->IsNumeric())
+		{
+			Query.ModifiedSince = FDateTime::FromUnixTimestamp(FCString::Atoi64(**ModifiedSince));
+		}
+		else
+		{
+			OnComplete(MakeErrorResponse(400, TEXT("Invalid 'modifiedSince' (expected ISO 8601 or Unix seconds)")));
+			return true;
+		}
+	}
+
+	const FBlueprintCatalogPage Page = FBlueprintAssetCatalog::Query(Query);
+
+	TArray<uint8> Body;
+	FMemoryWriter Archive(Body);
+	TSharedRef<FBlueprintSerializer::FUtf8JsonWriter> Writer = FBlueprintSerializer::FUtf8JsonWriter::Create(&Archive);
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("items"));
+	for (const FBlueprintCatalogEntry& Entry : Page.Entries)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Entry.Name);
+		Writer->WriteValue(TEXT("path"), Entry.Path);
+		Writer->WriteValue(TEXT("parentClass"), Entry.ParentClass);
+		Writer->WriteValue(TEXT("nativeParentClass"), Entry.NativeParentClass);
+		Writer->WriteValue(TEXT("blueprintType"), Entry.BlueprintType);
+		Writer->WriteValue(TEXT("numReplicatedProperties"), Entry.NumReplicatedProperties);
+		Writer->WriteValue(TEXT("isDataOnly"), Entry.bIsDataOnly);
+		Writer->WriteValue(TEXT("isLoaded"), Entry.bIsLoaded);
+		Writer->WriteValue(TEXT("modified"), Entry.Modified.ToIso8601());
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	if (Page.NextCursor.IsEmpty())
+	{
+		Writer->WriteNull(TEXT("nextCursor"));
+	}
+	else
+	{
+		Writer->WriteValue(TEXT("nextCursor"), Page.NextCursor);
+	}
+	Writer->WriteValue(TEXT("total"), Page.Total);
+	Writer->WriteValue(TEXT("complete"), Page.bComplete);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	SendResponse(Request, OnComplete, MoveTemp(Body), TEXT("application/json"));
 	return true;
 }
 
@@ -73,19 +167,76 @@ bool FHttpServerHandler::HandleGetBlueprint(const FHttpServerRequest& Request, c
 	UBlueprint* Blueprint = FindBlueprintByName(BlueprintName);
 	if (!Blueprint)
 	{
-		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Blueprint '%s' not found in editor"), *BlueprintName)));
+		if (DeferUntilLoaded(Request, OnComplete, { BlueprintName }, &FHttpServerHandler::HandleGetBlueprint))
+		{
+			return true;
+		}
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Blueprint '%s' not found"), *BlueprintName)));
 		return true;
 	}
 
-	// Get or create serializer for this blueprint
-	TSharedPtr<FBlueprintSerializer>& Serializer = Serializers.FindOrAdd(BlueprintName);
-	if (!Serializer.IsValid())
+	FBlueprintExportQuery Query;
+	FString QueryError;
+	if (!ParseExportQuery(Request, Query, QueryError))
 	{
-		Serializer = MakeShared<FBlueprintSerializer>();
+		OnComplete(MakeErrorResponse(400, QueryError));
+		return true;
+	}
+	TArray<UEdGraph*> Graphs;
+	if (!FBlueprintSerializer::GatherGraphs(Blueprint, Query.Graph, Graphs))
+	{
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Graph '%s' not found in blueprint '%s'"), *Query.Graph, *BlueprintName)));
+		return true;
+	}
+	const bool bPartial = !Query.IsFull();
+
+	// A client already holding this revision gets a 304 without the graph being serialized.
+	// Partial exports get their own tag per query, so one never validates another.
+	const bool bCompactBinary = HeaderHasMediaType(Request, TEXT("Accept"), CompactBinaryContentType);
+	const EBlueprintWireFormat Format = bCompactBinary ? EBlueprintWireFormat::CompactBinary : EBlueprintWireFormat::Json;
+	const uint64 Revision = Revisions.GetRevision(Blueprint);
+	FString Representation = bCompactBinary ? TEXT("cb") : TEXT("json");
+	if (bPartial)
+	{
+		Representation += FString::Printf(TEXT("-q%08x"), FCrc::StrCrc32(*Query.ToKey()));
+	}
+	const FString ETag = Revisions.MakeETag(Blueprint, *Representation);
+	if (MatchesIfNoneMatch(Request, ETag))
+	{
+		TUniquePtr<FHttpServerResponse> Response = MakeUnique<FHttpServerResponse>();
+		Response->Code = EHttpServerResponseCodes::NotModified;
+		Response->Headers.Add(TEXT("ETag"), TArray<FString>{ ETag });
+		OnComplete(MoveTemp(Response));
+		return true;
 	}
 
-	TSharedPtr<FJsonObject> Result = Serializer->SerializeBlueprint(Blueprint);
-	OnComplete(MakeJsonResponse(Result));
+	// Another client may have fetched this revision moments ago
+	const FString BlueprintPath = Blueprint->GetPathName();
+	const TCHAR* ContentType = bCompactBinary ? CompactBinaryContentType : TEXT("application/json");
+	TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Cached;
+	if (!bPartial && ExportCache.Find(BlueprintPath, Format, Revision, Cached))
+	{
+		SendResponse(Request, OnComplete, Cached.ToSharedRef(), ContentType, ETag);
+		return true;
+	}
+
+	TSharedPtr<FBlueprintSerializer> Serializer = FindOrCreateSerializer(Blueprint->GetPathName());
+
+	// Only the capture runs here; the body is encoded on the task graph and the reply completes from there.
+	// The serializer only calls back while it is alive, and it lives in our Serializers map.
+	// Partial exports are cheap to redo and too varied to be worth a cache slot.
+	Serializer->SerializeBlueprintAsync(Blueprint, Format,
+		[this, Request, OnComplete, BlueprintPath, Format, Revision, ContentType, ETag, bPartial](TArray<uint8>&& EncodedBody, const FBlueprintExportSnapshot&)
+		{
+			if (bPartial)
+			{
+				SendResponse(Request, OnComplete, MoveTemp(EncodedBody), ContentType, ETag);
+				return;
+			}
+			const FBlueprintExportCache::FBody Body = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(EncodedBody));
+			ExportCache.Add(BlueprintPath, Format, Revision, Body);
+			SendResponse(Request, OnComplete, Body, ContentType, ETag);
+		}, Query);
 	return true;
 }
 
@@ -98,30 +249,102 @@ bool FHttpServerHandler::HandleApplyBlueprint(const FHttpServerRequest& Request,
 	}
 	FString BlueprintName = Request.QueryParams[TEXT("name")];
 
-	// Parse request body
-	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
-	FString BodyString(Converter.Length(), Converter.Get());
+	// Park before decoding, so the body is only parsed once
+	if (!FindBlueprintByName(BlueprintName) && DeferUntilLoaded(Request, OnComplete, { BlueprintName }, &FHttpServerHandler::HandleApplyBlueprint))
+	{
+		return true;
+	}
 
-	TSharedPtr<FJsonObject> BodyJson;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BodyString);
-	if (!FJsonSerializer::Deserialize(Reader, BodyJson) || !BodyJson.IsValid())
+	// Inflate gzip bodies, then parse straight from the bytes into typed records
+	const double ParseStart = FPlatformTime::Seconds();
+	TArray<uint8> InflatedBody;
+	TConstArrayView<uint8> RequestBody;
+	if (!FHttpCompression::DecodeRequestBody(Request, InflatedBody, RequestBody))
 	{
-		OnComplete(MakeErrorResponse(400, TEXT("Invalid JSON body")));
+		OnComplete(MakeErrorResponse(400, TEXT("Unsupported or corrupt Content-Encoding")));
 		return true;
 	}
 
+	FBlueprintDeltaData Delta;
+	if (HeaderHasMediaType(Request, TEXT("Content-Type"), CompactBinaryContentType))
+	{
+		FBlueprintCbReader Reader(RequestBody);
+		if (!Reader.ReadDelta(Delta))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Rejected apply body: %s"), *Reader.GetError());
+			OnComplete(MakeErrorResponse(400, TEXT("Invalid Compact Binary body")));
+			return true;
+		}
+	}
+	else
+	{
+		FBlueprintJsonReader Reader(RequestBody);
+		if (!Reader.ReadDelta(Delta))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Rejected apply body: %s"), *Reader.GetError());
+			OnComplete(MakeErrorResponse(400, TEXT("Invalid JSON body")));
+			return true;
+		}
+	}
+	UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Parsed %s delta (%d bytes) in %.2f ms"),
+		*Delta.Type, RequestBody.Num(), (FPlatformTime::Seconds() - ParseStart) * 1000.0);
+
 	UBlueprint* Blueprint = FindBlueprintByName(BlueprintName);
 	if (!Blueprint)
 	{
 		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 		Response->SetBoolField(TEXT("success"), false);
 		Response->SetStringField(TEXT("error"),
-			FString::Printf(TEXT("Blueprint '%s' not found in editor"), *BlueprintName));
+			FString::Printf(TEXT("Blueprint '%s' not found"), *BlueprintName));
+		OnComplete(MakeJsonResponse(Response));
+		return true;
+	}
+
+	// Jobs reply straight away and queue behind whatever is already applying to this blueprint
+	if (IsAsyncRequest(Request))
+	{
+		return SubmitApplyJob(OnComplete, Blueprint, MoveTemp(Delta));
+	}
+
+	// One writer per blueprint: a sliced full sync still in progress owns the graph until it finishes
+	if (Deserializer.IsApplying(Blueprint))
+	{
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetBoolField(TEXT("success"), false);
+		Response->SetStringField(TEXT("error"),
+			FString::Printf(TEXT("Blueprint '%s' is still applying a previous full sync"), *BlueprintName));
+		OnComplete(MakeJsonResponse(Response));
+		return true;
+	}
+
+	// Large full syncs are spread over frames so the editor stays responsive; the reply waits for the last slice.
+	// The deserializer drops the callback if it is destroyed first, and it is destroyed with us.
+	if (Delta.Type == TEXT("FullSync") && Delta.FullState.IsSet() && ShouldSliceApply(Request, Delta.FullState.GetValue()))
+	{
+		const bool bStarted = Deserializer.ApplyFullSyncSliced(Blueprint, MoveTemp(Delta.FullState.GetValue()),
+			[this, OnComplete](bool bSliceSuccess)
+			{
+				TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+				Response->SetBoolField(TEXT("success"), bSliceSuccess);
+				if (!bSliceSuccess)
+				{
+					Response->SetStringField(TEXT("error"), TEXT("Failed to apply blueprint changes"));
+				}
+				OnComplete(MakeJsonResponse(Response));
+			});
+		if (bStarted)
+		{
+			return true;
+		}
+
+		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetBoolField(TEXT("success"), false);
+		Response->SetStringField(TEXT("error"), TEXT("Failed to apply blueprint changes"));
 		OnComplete(MakeJsonResponse(Response));
 		return true;
 	}
 
-	bool bSuccess = Deserializer.ApplyFullSync(Blueprint, BodyJson);
+	bool bSuccess = Deserializer.ApplyDelta(Blueprint, Delta);
 
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), bSuccess);
@@ -133,30 +356,161 @@ bool FHttpServerHandler::HandleApplyBlueprint(const FHttpServerRequest& Request,
 	return true;
 }
 
+bool FHttpServerHandler::HandleApplyProgress(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (!Request.QueryParams.Contains(TEXT("name")))
+	{
+		OnComplete(MakeErrorResponse(400, TEXT("Missing 'name' query parameter")));
+		return true;
+	}
+	FString BlueprintName = Request.QueryParams[TEXT("name")];
+
+	UBlueprint* Blueprint = FindBlueprintByName(BlueprintName);
+	if (!Blueprint)
+	{
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Blueprint '%s' not found"), *BlueprintName)));
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	FBlueprintApplyProgress Progress;
+	const bool bActive = Deserializer.GetApplyProgress(Blueprint, Progress);
+	Response->SetBoolField(TEXT("active"), bActive);
+	Response->SetBoolField(TEXT("compilePending"), Compiles.IsPending(Blueprint));
+	if (bActive)
+	{
+		Response->SetStringField(TEXT("phase"), Progress.Phase);
+		Response->SetNumberField(TEXT("nodesProcessed"), Progress.NodesProcessed);
+		Response->SetNumberField(TEXT("nodesTotal"), Progress.NodesTotal);
+		Response->SetNumberField(TEXT("nodesCreated"), Progress.NodesCreated);
+		Response->SetNumberField(TEXT("linksWired"), Progress.LinksWired);
+		Response->SetNumberField(TEXT("linksTotal"), Progress.LinksTotal);
+		Response->SetNumberField(TEXT("elapsedMs"), Progress.ElapsedSeconds * 1000.0);
+	}
+	OnComplete(MakeJsonResponse(Response));
+	return true;
+}
+
+bool FHttpServerHandler::HandleCompileBlueprint(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (!Request.QueryParams.Contains(TEXT("name")))
+	{
+		OnComplete(MakeErrorResponse(400, TEXT("Missing 'name' query parameter")));
+		return true;
+	}
+	FString BlueprintName = Request.QueryParams[TEXT("name")];
+
+	if (DeferUntilLoaded(Request, OnComplete, { BlueprintName }, &FHttpServerHandler::HandleCompileBlueprint))
+	{
+		return true;
+	}
+
+	UBlueprint* Blueprint = FindBlueprintByName(BlueprintName);
+	if (!Blueprint)
+	{
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Blueprint '%s' not found"), *BlueprintName)));
+		return true;
+	}
+
+	if (Deserializer.IsApplying(Blueprint))
+	{
+		TSharedPtr<FJsonObject> Busy = MakeShared<FJsonObject>();
+		Busy->SetBoolField(TEXT("success"), false);
+		Busy->SetStringField(TEXT("error"), TEXT("Blueprint is still applying a previous full sync"));
+		OnComplete(MakeJsonResponse(Busy));
+		return true;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FBlueprintCompileResult Result = Compiles.CompileNow({ Blueprint })[0];
+
+	auto MessagesToJson = [](const TArray<FBlueprintCompileMessage>& Messages)
+	{
+		TArray<TSharedPtr<FJsonValue>> Array;
+		for (const FBlueprintCompileMessage& Message : Messages)
+		{
+			TSharedPtr<FJsonObject> MessageJson = MakeShared<FJsonObject>();
+			MessageJson->SetStringField(TEXT("nodeId"), Message.NodeId);
+			MessageJson->SetStringField(TEXT("node"), Message.NodeTitle);
+			MessageJson->SetStringField(TEXT("message"), Message.Message);
+			Array.Add(MakeShared<FJsonValueObject>(MessageJson));
+		}
+		return Array;
+	};
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetBoolField(TEXT("success"), !Result.HasErrors());
+	Response->SetStringField(TEXT("name"), Result.Name);
+	Response->SetStringField(TEXT("path"), Result.Path);
+	Response->SetStringField(TEXT("status"), Result.Status);
+	Response->SetArrayField(TEXT("errors"), MessagesToJson(Result.Errors));
+	Response->SetArrayField(TEXT("warnings"), MessagesToJson(Result.Warnings));
+	Response->SetNumberField(TEXT("compileMs"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	OnComplete(MakeJsonResponse(Response));
+	return true;
+}
+
+bool FHttpServerHandler::ShouldSliceApply(const FHttpServerRequest& Request, const FBlueprintStateData& State)
+{
+	// ?sliced=true|false overrides; otherwise only payloads big enough to stall a frame are sliced
+	if (const FString* Sliced = Request.QueryParams.Find(TEXT("sliced")))
+	{
+		return Sliced->ToBool();
+	}
+	return State.Nodes.Num() + State.Connections.Num() >= SlicedApplyThreshold;
+}
+
 bool FHttpServerHandler::HandleCreateBlueprint(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
 	// Parse request body: { "name": "BP_MyBlueprint", "path": "/Game/Blueprints", "parentClass": "Actor", "state": { ... } }
-	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
-	FString BodyString(Converter.Length(), Converter.Get());
-
-	TSharedPtr<FJsonObject> BodyJson;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BodyString);
-	if (!FJsonSerializer::Deserialize(Reader, BodyJson) || !BodyJson.IsValid())
+	const double ParseStart = FPlatformTime::Seconds();
+	FBlueprintJsonReader Reader(Request.Body);
+	FBlueprintCreateRequest CreateRequest;
+	if (!Reader.ReadCreateRequest(CreateRequest))
 	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Rejected create body: %s"), *Reader.GetError());
 		OnComplete(MakeErrorResponse(400, TEXT("Invalid JSON body")));
 		return true;
 	}
+	UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Parsed create request (%d bytes) in %.2f ms"),
+		Request.Body.Num(), (FPlatformTime::Seconds() - ParseStart) * 1000.0);
 
-	FString Name = BodyJson->GetStringField(TEXT("name"));
-	FString Path = BodyJson->HasField(TEXT("path")) ? BodyJson->GetStringField(TEXT("path")) : TEXT("/Game/Blueprints");
-	FString ParentClassName = BodyJson->HasField(TEXT("parentClass")) ? BodyJson->GetStringField(TEXT("parentClass")) : TEXT("Actor");
-
-	if (Name.IsEmpty())
+	if (CreateRequest.Name.IsEmpty())
 	{
 		OnComplete(MakeErrorResponse(400, TEXT("Missing 'name' field")));
 		return true;
 	}
 
+	if (IsAsyncRequest(Request))
+	{
+		return SubmitCreateJob(OnComplete, MoveTemp(CreateRequest));
+	}
+
+	FString Error;
+	UBlueprint* NewBlueprint = CreateBlueprintAsset(CreateRequest, Error);
+	if (!NewBlueprint)
+	{
+		OnComplete(MakeErrorResponse(500, Error));
+		return true;
+	}
+
+	// Apply initial state if provided
+	if (CreateRequest.State.IsSet())
+	{
+		Deserializer.ApplyFullSync(NewBlueprint, CreateRequest.State.GetValue());
+	}
+
+	SaveAndOpenBlueprint(NewBlueprint);
+	OnComplete(MakeJsonResponse(MakeCreateResult(NewBlueprint)));
+	return true;
+}
+
+UBlueprint* FHttpServerHandler::CreateBlueprintAsset(const FBlueprintCreateRequest& CreateRequest, FString& OutError)
+{
+	const FString& Name = CreateRequest.Name;
+	const FString& Path = CreateRequest.Path;
+	const FString& ParentClassName = CreateRequest.ParentClass;
+
 	// Resolve parent class
 	UClass* ParentClass = AActor::StaticClass(); // default
 	if (ParentClassName == TEXT("Pawn"))
@@ -187,8 +541,8 @@ bool FHttpServerHandler::HandleCreateBlueprint(const FHttpServerRequest& Request
 	UPackage* Package = CreatePackage(*PackagePath);
 	if (!Package)
 	{
-		OnComplete(MakeErrorResponse(500, FString::Printf(TEXT("Failed to create package at '%s'"), *PackagePath)));
-		return true;
+		OutError = FString::Printf(TEXT("Failed to create package at '%s'"), *PackagePath);
+		return nullptr;
 	}
 
 	UBlueprint* NewBlueprint = FKismetEditorUtilities::CreateBlueprint(
@@ -202,60 +556,498 @@ bool FHttpServerHandler::HandleCreateBlueprint(const FHttpServerRequest& Request
 
 	if (!NewBlueprint)
 	{
-		OnComplete(MakeErrorResponse(500, TEXT("Failed to create blueprint")));
-		return true;
+		OutError = TEXT("Failed to create blueprint");
+		return nullptr;
 	}
 
-	// Apply initial state if provided
-	const TSharedPtr<FJsonObject>* StateJson;
-	if (BodyJson->TryGetObjectField(TEXT("state"), StateJson))
-	{
-		Deserializer.ApplyFullSync(NewBlueprint, *StateJson);
-	}
+	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Created new blueprint '%s' at '%s'"), *Name, *PackagePath);
+	return NewBlueprint;
+}
+
+void FHttpServerHandler::SaveAndOpenBlueprint(UBlueprint* NewBlueprint)
+{
+	// Don't leave the initial state's compile to the quiet period; the package is saved with its class
+	Compiles.CompileNow({ NewBlueprint });
 
 	// Mark dirty and save
 	NewBlueprint->MarkPackageDirty();
 	FAssetRegistryModule::AssetCreated(NewBlueprint);
 
 	// Save the asset
+	UPackage* Package = NewBlueprint->GetOutermost();
 	FSavePackageArgs SaveArgs;
 	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension());
+	FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
 	UPackage::SavePackage(Package, NewBlueprint, *PackageFileName, SaveArgs);
 
 	// Open in editor
 	GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewBlueprint);
+}
 
+TSharedPtr<FJsonObject> FHttpServerHandler::MakeCreateResult(UBlueprint* NewBlueprint)
+{
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("name"), NewBlueprint->GetName());
 	Response->SetStringField(TEXT("path"), NewBlueprint->GetPathName());
+	return Response;
+}
 
-	UE_LOG(LogTemp, Log, TEXT("BlueprintAIBridge: Created new blueprint '%s' at '%s'"), *Name, *PackagePath);
+TSharedPtr<FJsonObject> FHttpServerHandler::MakeApplyResult(bool bSuccess, const FString& Error)
+{
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetBoolField(TEXT("success"), bSuccess);
+	if (!bSuccess)
+	{
+		Response->SetStringField(TEXT("error"), Error);
+	}
+	return Response;
+}
+
+bool FHttpServerHandler::IsAsyncRequest(const FHttpServerRequest& Request)
+{
+	const FString* Async = Request.QueryParams.Find(TEXT("async"));
+	return Async && Async->ToBool();
+}
+
+void FHttpServerHandler::SendJobAccepted(const FHttpResultCallback& OnComplete, const FBridgeJob& Job)
+{
+	const FString StatusPath = FString::Printf(TEXT("/api/jobs/%s"), *Job.Id);
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetStringField(TEXT("jobId"), Job.Id);
+	Response->SetStringField(TEXT("status"), StatusPath);
+
+	TUniquePtr<FHttpServerResponse> HttpResponse = MakeJsonResponse(Response);
+	HttpResponse->Code = EHttpServerResponseCodes::Accepted;
+	HttpResponse->Headers.Add(TEXT("Location"), TArray<FString>{ StatusPath });
+	OnComplete(MoveTemp(HttpResponse));
+}
+
+bool FHttpServerHandler::StartSlicedJob(FBridgeJob& Job, UBlueprint* Blueprint, FBlueprintStateData&& State,
+	TFunction<void(bool bSuccess)>&& OnApplied)
+{
+	Job.Phase = TEXT("applying");
+	Job.Blueprint = Blueprint;
+	if (!Deserializer.ApplyFullSyncSliced(Blueprint, MoveTemp(State), MoveTemp(OnApplied)))
+	{
+		return false;
+	}
+
+	// Cancelling stops the remaining slices; once compiling, the deserializer refuses
+	TWeakObjectPtr<UBlueprint> WeakBlueprint = Blueprint;
+	Job.Cancel = [this, WeakBlueprint]()
+	{
+		UBlueprint* Target = WeakBlueprint.Get();
+		return Target && Deserializer.CancelSlicedSync(Target);
+	};
+	return true;
+}
+
+bool FHttpServerHandler::SubmitApplyJob(const FHttpResultCallback& OnComplete, UBlueprint* Blueprint, FBlueprintDeltaData&& Delta)
+{
+	// Jobs live in our queue and the deserializer drops its callbacks when destroyed, so capturing this is safe
+	TWeakObjectPtr<UBlueprint> WeakBlueprint = Blueprint;
+	TSharedRef<FBlueprintDeltaData> SharedDelta = MakeShared<FBlueprintDeltaData>(MoveTemp(Delta));
+	TSharedRef<FBridgeJob> Submitted = Jobs.Submit(TEXT("apply"), Blueprint->GetPathName(), [this, WeakBlueprint, SharedDelta](FBridgeJob& Job)
+	{
+		UBlueprint* Target = WeakBlueprint.Get();
+		if (!Target)
+		{
+			Jobs.Finish(Job.Id, false, MakeApplyResult(false, TEXT("Blueprint was unloaded before the job started")));
+			return true;
+		}
+
+		// Wait our turn behind a sliced sync already running on this blueprint
+		if (Deserializer.IsApplying(Target))
+		{
+			return false;
+		}
+
+		if (SharedDelta->Type == TEXT("FullSync") && SharedDelta->FullState.IsSet())
+		{
+			const FString JobId = Job.Id;
+			if (!StartSlicedJob(Job, Target, MoveTemp(SharedDelta->FullState.GetValue()), [this, JobId](bool bSuccess)
+				{
+					Jobs.Finish(JobId, bSuccess, MakeApplyResult(bSuccess, TEXT("Failed to apply blueprint changes")));
+				}))
+			{
+				Jobs.Finish(Job.Id, false, MakeApplyResult(false, TEXT("Failed to apply blueprint changes")));
+			}
+			return true;
+		}
+
+		// Typed deltas are small; apply them in one go
+		Job.Phase = TEXT("applying");
+		const bool bSuccess = Deserializer.ApplyDelta(Target, *SharedDelta);
+		Jobs.Finish(Job.Id, bSuccess, MakeApplyResult(bSuccess, TEXT("Failed to apply blueprint changes")));
+		return true;
+	});
+
+	SendJobAccepted(OnComplete, *Submitted);
+	return true;
+}
+
+bool FHttpServerHandler::SubmitCreateJob(const FHttpResultCallback& OnComplete, FBlueprintCreateRequest&& CreateRequest)
+{
+	TSharedRef<FBlueprintCreateRequest> SharedRequest = MakeShared<FBlueprintCreateRequest>(MoveTemp(CreateRequest));
+	const FString Target = SharedRequest->Path / SharedRequest->Name;
+	TSharedRef<FBridgeJob> Submitted = Jobs.Submit(TEXT("create"), Target, [this, SharedRequest](FBridgeJob& Job)
+	{
+		Job.Phase = TEXT("creating");
+		FString Error;
+		UBlueprint* NewBlueprint = CreateBlueprintAsset(*SharedRequest, Error);
+		if (!NewBlueprint)
+		{
+			Jobs.Finish(Job.Id, false, MakeApplyResult(false, Error));
+			return true;
+		}
+
+		// The package is saved once the initial state (and its compile) has landed
+		const FString JobId = Job.Id;
+		TWeakObjectPtr<UBlueprint> WeakBlueprint = NewBlueprint;
+		auto SaveAndFinish = [this, JobId, WeakBlueprint](bool bApplied)
+		{
+			UBlueprint* Created = WeakBlueprint.Get();
+			if (!Created)
+			{
+				Jobs.Finish(JobId, false, MakeApplyResult(false, TEXT("Blueprint was destroyed before it could be saved")));
+				return;
+			}
+			if (TSharedPtr<FBridgeJob> Running = Jobs.Find(JobId))
+			{
+				Running->Phase = TEXT("saving");
+				Running->Cancel = nullptr;
+			}
+			SaveAndOpenBlueprint(Created);
+
+			TSharedPtr<FJsonObject> Result = MakeCreateResult(Created);
+			if (!bApplied)
+			{
+				Result->SetStringField(TEXT("warning"), TEXT("Initial state could not be fully applied"));
+			}
+			Jobs.Finish(JobId, true, Result);
+		};
+
+		if (!SharedRequest->State.IsSet())
+		{
+			SaveAndFinish(true);
+			return true;
+		}
+		if (!StartSlicedJob(Job, NewBlueprint, MoveTemp(SharedRequest->State.GetValue()), MoveTemp(SaveAndFinish)))
+		{
+			Jobs.Finish(Job.Id, false, MakeApplyResult(false, TEXT("Failed to apply the initial state")));
+		}
+		return true;
+	});
+
+	SendJobAccepted(OnComplete, *Submitted);
+	return true;
+}
+
+bool FHttpServerHandler::HandleGetJob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const FString JobId = Request.PathParams.FindRef(TEXT("id"));
+	TSharedPtr<FBridgeJob> Job = Jobs.Find(JobId);
+	if (!Job.IsValid())
+	{
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Job '%s' not found"), *JobId)));
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetStringField(TEXT("id"), Job->Id);
+	Response->SetStringField(TEXT("kind"), Job->Kind);
+	Response->SetStringField(TEXT("target"), Job->Target);
+	Response->SetStringField(TEXT("state"), FBridgeJobQueue::LexState(Job->State));
+	Response->SetStringField(TEXT("phase"), Job->Phase);
+
+	// A running apply reports where its slices have got to
+	FBlueprintApplyProgress Progress;
+	UBlueprint* Blueprint = Job->Blueprint.Get();
+	if (Job->State == EBridgeJobState::Running && Blueprint && Deserializer.GetApplyProgress(Blueprint, Progress))
+	{
+		TSharedPtr<FJsonObject> ProgressJson = MakeShared<FJsonObject>();
+		ProgressJson->SetStringField(TEXT("phase"), Progress.Phase);
+		ProgressJson->SetNumberField(TEXT("nodesProcessed"), Progress.NodesProcessed);
+		ProgressJson->SetNumberField(TEXT("nodesTotal"), Progress.NodesTotal);
+		ProgressJson->SetNumberField(TEXT("nodesCreated"), Progress.NodesCreated);
+		ProgressJson->SetNumberField(TEXT("linksWired"), Progress.LinksWired);
+		ProgressJson->SetNumberField(TEXT("linksTotal"), Progress.LinksTotal);
+		Response->SetObjectField(TEXT("progress"), ProgressJson);
+	}
 
+	const double StartTime = Job->StartTime > 0.0 ? Job->StartTime : Now;
+	const double EndTime = Job->IsFinished() ? Job->FinishTime : Now;
+	TSharedPtr<FJsonObject> Timings = MakeShared<FJsonObject>();
+	Timings->SetNumberField(TEXT("queuedMs"), (StartTime - Job->QueuedTime) * 1000.0);
+	Timings->SetNumberField(TEXT("runningMs"), FMath::Max(EndTime - StartTime, 0.0) * 1000.0);
+	Timings->SetNumberField(TEXT("totalMs"), (EndTime - Job->QueuedTime) * 1000.0);
+	Response->SetObjectField(TEXT("timings"), Timings);
+
+	if (Job->Result.IsValid())
+	{
+		Response->SetObjectField(TEXT("result"), Job->Result);
+	}
 	OnComplete(MakeJsonResponse(Response));
 	return true;
 }
 
-UBlueprint* FHttpServerHandler::FindBlueprintByName(const FString& Name) const
+bool FHttpServerHandler::HandleCancelJob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
-	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-	if (!AssetEditorSubsystem)
+	const FString JobId = Request.PathParams.FindRef(TEXT("id"));
+	TSharedPtr<FBridgeJob> Job = Jobs.Find(JobId);
+	if (!Job.IsValid())
 	{
-		return nullptr;
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Job '%s' not found"), *JobId)));
+		return true;
+	}
+
+	if (!Jobs.Cancel(*Job))
+	{
+		OnComplete(MakeErrorResponse(409, FString::Printf(TEXT("Job '%s' is %s and can no longer be cancelled"),
+			*JobId, Job->IsFinished() ? FBridgeJobQueue::LexState(Job->State) : *Job->Phase)));
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetStringField(TEXT("id"), Job->Id);
+	Response->SetStringField(TEXT("state"), FBridgeJobQueue::LexState(Job->State));
+	OnComplete(MakeJsonResponse(Response));
+	return true;
+}
+
+bool FHttpServerHandler::ParseExportQuery(const FHttpServerRequest& Request, FBlueprintExportQuery& OutQuery, FString& OutError)
+{
+	OutQuery.Graph = Request.QueryParams.FindRef(TEXT("graph"));
+
+	if (const FString* Region = Request.QueryParams.Find(TEXT("region")))
+	{
+		TArray<FString> Bounds;
+		Region->ParseIntoArray(Bounds, TEXT(","));
+		if (Bounds.Num() != 4 || !Bounds[0].IsNumeric() || !Bounds[1].IsNumeric() || !Bounds[2].IsNumeric() || !Bounds[3].IsNumeric())
+		{
+			OutError = TEXT("Invalid 'region' (expected x0,y0,x1,y1)");
+			return false;
+		}
+		const FVector2D Corner0(FCString::Atod(*Bounds[0]), FCString::Atod(*Bounds[1]));
+		const FVector2D Corner1(FCString::Atod(*Bounds[2]), FCString::Atod(*Bounds[3]));
+		OutQuery.Region = FBox2D(FVector2D::Min(Corner0, Corner1), FVector2D::Max(Corner0, Corner1));
+	}
+
+	if (const FString* Nodes = Request.QueryParams.Find(TEXT("nodes")))
+	{
+		TArray<FString> NodeIds;
+		Nodes->ParseIntoArray(NodeIds, TEXT(","));
+		for (const FString& NodeId : NodeIds)
+		{
+			FGuid Guid;
+			if (!FGuid::Parse(NodeId, Guid))
+			{
+				OutError = FString::Printf(TEXT("Invalid node ID '%s'"), *NodeId);
+				return false;
+			}
+			OutQuery.NodeGuids.Add(Guid);
+		}
+		if (OutQuery.NodeGuids.Num() == 0)
+		{
+			OutError = TEXT("'nodes' lists no node IDs");
+			return false;
+		}
+	}
+	if (const FString* Hops = Request.QueryParams.Find(TEXT("hops")))
+	{
+		if (!Hops->IsNumeric())
+		{
+			OutError = TEXT("Invalid 'hops'");
+			return false;
+		}
+		OutQuery.Hops = FMath::Clamp(FCString::Atoi(**Hops), 0, MaxExportHops);
+	}
+
+	if (const FString* Fields = Request.QueryParams.Find(TEXT("fields")))
+	{
+		static const TPair<const TCHAR*, EBlueprintExportFields> FieldNames[] = {
+			{ TEXT("title"), EBlueprintExportFields::Title },
+			{ TEXT("category"), EBlueprintExportFields::Category },
+			{ TEXT("style"), EBlueprintExportFields::Style },
+			{ TEXT("position"), EBlueprintExportFields::Position },
+			{ TEXT("pins"), EBlueprintExportFields::Pins },
+			{ TEXT("connections"), EBlueprintExportFields::Connections },
+			{ TEXT("variables"), EBlueprintExportFields::Variables },
+		};
+
+		TArray<FString> Names;
+		Fields->ParseIntoArray(Names, TEXT(","));
+		OutQuery.Fields = EBlueprintExportFields::None;
+		for (const FString& Name : Names)
+		{
+			const TPair<const TCHAR*, EBlueprintExportFields>* Field = Algo::FindByPredicate(FieldNames,
+				[&Name](const TPair<const TCHAR*, EBlueprintExportFields>& Candidate) { return Name.Equals(Candidate.Key, ESearchCase::IgnoreCase); });
+			if (!Field)
+			{
+				OutError = FString::Printf(TEXT("Unknown field '%s' (expected title, category, style, position, pins, connections, variables)"), *Name);
+				return false;
+			}
+			OutQuery.Fields |= Field->Value;
+		}
+	}
+	return true;
+}
+
+UBlueprint* FHttpServerHandler::FindBlueprintByName(const FString& Name)
+{
+	// Accepts "BP_Enemy", "/Game/AI/BP_Enemy" or "/Game/AI/BP_Enemy.BP_Enemy", open in an editor or merely loaded
+	return Lookup.Find(Name);
+}
+
+bool FHttpServerHandler::LoadBlueprintsAsync(const TArray<FString>& Names, TFunction<void()>&& OnLoaded)
+{
+	return Lookup.LoadAsync(Names, MoveTemp(OnLoaded));
+}
+
+bool FHttpServerHandler::DeferUntilLoaded(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete,
+	const TArray<FString>& Names, FRouteHandler Route)
+{
+	// The lookup index drops its waiters when it is destroyed with us, so capturing this is safe. On the
+	// second pass the loaded names resolve and failed loads are not retried, so the route can't park again.
+	const double ParkStart = FPlatformTime::Seconds();
+	return Lookup.LoadAsync(Names, [this, Request, OnComplete, Route, ParkStart]()
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Resuming %s after %.2f ms waiting on asset load"),
+			*Request.RelativePath.GetPath(), (FPlatformTime::Seconds() - ParkStart) * 1000.0);
+		(this->*Route)(Request, OnComplete);
+	});
+}
+
+TSharedPtr<FBlueprintSerializer> FHttpServerHandler::FindOrCreateSerializer(const FString& BlueprintPath)
+{
+	TSharedPtr<FBlueprintSerializer>& Serializer = Serializers.FindOrAdd(BlueprintPath);
+	if (!Serializer.IsValid())
+	{
+		Serializer = MakeShared<FBlueprintSerializer>();
 	}
+	return Serializer;
+}
 
-	TArray<UObject*> EditedAssets = AssetEditorSubsystem->GetAllEditedAssets();
-	for (UObject* Asset : EditedAssets)
+void FHttpServerHandler::OnBlueprintRevisionChanged(UBlueprint* Blueprint)
+{
+	ExportCache.Invalidate(Blueprint->GetPathName());
+}
+
+void FHttpServerHandler::SendResponse(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete,
+	TArray<uint8>&& Body, const FString& ContentType, const FString& ETag)
+{
+	const FName Encoding = Body.Num() >= FHttpCompression::MinCompressedBodySize ? FHttpCompression::NegotiateEncoding(Request) : NAME_None;
+	if (Encoding.IsNone())
 	{
-		UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
-		if (Blueprint && Blueprint->GetName() == Name)
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(Body), ContentType);
+		if (!ETag.IsEmpty())
 		{
-			return Blueprint;
+			Response->Headers.Add(TEXT("ETag"), TArray<FString>{ ETag });
 		}
+		OnComplete(MoveTemp(Response));
+		return;
+	}
+
+	SendCompressed(OnComplete, MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Body)), ContentType, ETag, Encoding);
+}
+
+void FHttpServerHandler::SendResponse(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete,
+	const FBlueprintExportCache::FBody& Body, const FString& ContentType, const FString& ETag)
+{
+	const FName Encoding = Body->Num() >= FHttpCompression::MinCompressedBodySize ? FHttpCompression::NegotiateEncoding(Request) : NAME_None;
+	if (Encoding.IsNone())
+	{
+		// FHttpServerResponse owns its body as a TArray, so this is the one copy a shared body costs per response
+		SendResponse(Request, OnComplete, TArray<uint8>(*Body), ContentType, ETag);
+		return;
 	}
 
-	return nullptr;
+	SendCompressed(OnComplete, Body, ContentType, ETag, Encoding);
+}
+
+void FHttpServerHandler::SendCompressed(const FHttpResultCallback& OnComplete, const FBlueprintExportCache::FBody& Body,
+	const FString& ContentType, const FString& ETag, FName Encoding)
+{
+	// Compress on a pool thread, then complete on the game thread where the server expects it
+	Async(EAsyncExecution::ThreadPool, [Body, ContentType, ETag, Encoding, OnComplete]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 RawSize = Body->Num();
+		TArray<uint8> Compressed;
+		const bool bCompressed = FHttpCompression::Compress(Encoding, *Body, Compressed);
+		if (bCompressed)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: %s-encoded response %d -> %d bytes in %.2f ms"),
+				FHttpCompression::GetEncodingName(Encoding), RawSize, Compressed.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+		else
+		{
+			// Sent uncompressed; the response needs its own TArray, as above
+			Compressed = *Body;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Compressed = MoveTemp(Compressed), ContentType, ETag, Encoding, bCompressed, OnComplete]() mutable
+		{
+			TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(Compressed), ContentType);
+			if (bCompressed)
+			{
+				Response->Headers.Add(TEXT("Content-Encoding"), TArray<FString>{ FHttpCompression::GetEncodingName(Encoding) });
+			}
+			Response->Headers.Add(TEXT("Vary"), TArray<FString>{ TEXT("Accept-Encoding") });
+			if (!ETag.IsEmpty())
+			{
+				Response->Headers.Add(TEXT("ETag"), TArray<FString>{ ETag });
+			}
+			OnComplete(MoveTemp(Response));
+		});
+	});
+}
+
+bool FHttpServerHandler::MatchesIfNoneMatch(const FHttpServerRequest& Request, const FString& ETag)
+{
+	const TArray<FString>* Values = Request.Headers.Find(TEXT("If-None-Match"));
+	if (!Values)
+	{
+		return false;
+	}
+
+	for (const FString& Value : *Values)
+	{
+		TArray<FString> Tags;
+		Value.ParseIntoArray(Tags, TEXT(","));
+		for (FString& Tag : Tags)
+		{
+			Tag.TrimStartAndEndInline();
+			Tag.RemoveFromStart(TEXT("W/"));
+			if (Tag == TEXT("*") || Tag.Equals(ETag, ESearchCase::CaseSensitive))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool FHttpServerHandler::HeaderHasMediaType(const FHttpServerRequest& Request, const TCHAR* Header, const TCHAR* MediaType)
+{
+	// Header names are matched case-insensitively by the FString-keyed map
+	const TArray<FString>* Values = Request.Headers.Find(Header);
+	if (!Values)
+	{
+		return false;
+	}
+
+	for (const FString& Value : *Values)
+	{
+		if (Value.Contains(MediaType))
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 TUniquePtr<FHttpServerResponse> FHttpServerHandler::MakeJsonResponse(const TSharedPtr<FJsonObject>& Json)
@@ -276,5 +1068,247 @@ TUniquePtr<FHttpServerResponse> FHttpServerHandler::MakeErrorResponse(int32 Code
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(ErrorJson.ToSharedRef(), Writer);
 
-	return FHttpServerResponse::Create(OutputString, TEXT("application/json"));
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(OutputString, TEXT("application/json"));
+	Response->Code = static_cast<EHttpServerResponseCodes>(Code);
+	return Response;
+}
+
+bool FHttpServerHandler::HandleBlueprintEvents(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (!Request.QueryParams.Contains(TEXT("name")))
+	{
+		OnComplete(MakeErrorResponse(400, TEXT("Missing 'name' query parameter")));
+		return true;
+	}
+	FString BlueprintName = Request.QueryParams[TEXT("name")];
+
+	UBlueprint* Blueprint = FindBlueprintByName(BlueprintName);
+	if (!Blueprint)
+	{
+		if (DeferUntilLoaded(Request, OnComplete, { BlueprintName }, &FHttpServerHandler::HandleBlueprintEvents))
+		{
+			return true;
+		}
+		OnComplete(MakeErrorResponse(404, FString::Printf(TEXT("Blueprint '%s' not found"), *BlueprintName)));
+		return true;
+	}
+
+	// EventSource resends the last id it saw on reconnect; plain pollers can pass ?since= instead
+	TOptional<uint64> LastEventId;
+	const TArray<FString>* LastEventIdHeader = Request.Headers.Find(TEXT("Last-Event-ID"));
+	if (LastEventIdHeader && LastEventIdHeader->Num() > 0)
+	{
+		LastEventId = FCString::Strtoui64(*(*LastEventIdHeader)[0], nullptr, 10);
+	}
+	else if (const FString* Since = Request.QueryParams.Find(TEXT("since")))
+	{
+		LastEventId = FCString::Strtoui64(**Since, nullptr, 10);
+	}
+
+	ChangeFeed.Subscribe(Blueprint, LastEventId, OnComplete);
+	return true;
+}
+
+bool FHttpServerHandler::HandleBatchGetBlueprints(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	// Parse request body: { "names": ["BP_Player", "/Game/AI/BP_Enemy", ...] }
+	FBlueprintJsonReader Reader(Request.Body);
+	TArray<FString> Names;
+	if (!Reader.ReadNameList(Names))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BlueprintAIBridge: Rejected batch-get body: %s"), *Reader.GetError());
+		OnComplete(MakeErrorResponse(400, TEXT("Invalid JSON body")));
+		return true;
+	}
+
+	// Stream in every unloaded blueprint first, so the batch is captured in a single pass
+	if (DeferUntilLoaded(Request, OnComplete, Names, &FHttpServerHandler::HandleBatchGetBlueprints))
+	{
+		return true;
+	}
+
+	struct FBatchItem
+	{
+		FString Name;
+		int32 Status = 200;
+		FString Error;
+		FString Path;
+		FString ETag;
+		uint64 Revision = 0;
+		/** Set for every item with status 200: the cached body, or the one encoded for this batch */
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Body;
+		TSharedPtr<FBlueprintSerializer> Serializer;
+		TSharedPtr<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Snapshot;
+		/** Earlier item naming the same blueprint, whose body this one reuses */
+		int32 SameAs = INDEX_NONE;
+	};
+
+	const bool bCompactBinary = HeaderHasMediaType(Request, TEXT("Accept"), CompactBinaryContentType);
+	const EBlueprintWireFormat Format = bCompactBinary ? EBlueprintWireFormat::CompactBinary : EBlueprintWireFormat::Json;
+
+	// One game-thread pass: resolve every name, answer what the export cache can, capture the rest
+	const double CaptureStart = FPlatformTime::Seconds();
+	TSharedRef<TArray<FBatchItem>, ESPMode::ThreadSafe> Items = MakeShared<TArray<FBatchItem>, ESPMode::ThreadSafe>();
+	Items->Reserve(Names.Num());
+	TMap<UBlueprint*, int32> SeenBlueprints;
+	int32 CaptureCount = 0;
+
+	for (const FString& Name : Names)
+	{
+		FBatchItem& Item = Items->AddDefaulted_GetRef();
+		Item.Name = Name;
+
+		UBlueprint* Blueprint = FindBlueprintByName(Name);
+		if (!Blueprint)
+		{
+			Item.Status = 404;
+			Item.Error = FString::Printf(TEXT("Blueprint '%s' not found"), *Name);
+			continue;
+		}
+
+		if (const int32* Seen = SeenBlueprints.Find(Blueprint))
+		{
+			Item.SameAs = *Seen;
+			continue;
+		}
+		SeenBlueprints.Add(Blueprint, Items->Num() - 1);
+
+		Item.Path = Blueprint->GetPathName();
+		Item.Revision = Revisions.GetRevision(Blueprint);
+		Item.ETag = Revisions.MakeETag(Blueprint, bCompactBinary ? TEXT("cb") : TEXT("json"));
+		if (!ExportCache.Find(Item.Path, Format, Item.Revision, Item.Body))
+		{
+			Item.Serializer = FindOrCreateSerializer(Blueprint->GetPathName());
+			Item.Snapshot = Item.Serializer->Capture(Blueprint, Format);
+			CaptureCount++;
+		}
+	}
+	const double CaptureSeconds = FPlatformTime::Seconds() - CaptureStart;
+
+	// Encode the captured exports side by side, then finish on the game thread, unless the handler has gone away
+	// (module shutdown) in the meantime
+	FHttpServerRequest RequestCopy = Request;
+	TWeakPtr<FHttpServerHandler> WeakThis = AsShared();
+	Async(EAsyncExecution::TaskGraph, [WeakThis, Items, RequestCopy = MoveTemp(RequestCopy), OnComplete, bCompactBinary, Format, CaptureSeconds, CaptureCount]() mutable
+	{
+		const double EncodeStart = FPlatformTime::Seconds();
+		ParallelFor(Items->Num(), [&Items](int32 Index)
+		{
+			FBatchItem& Item = (*Items)[Index];
+			if (Item.Snapshot.IsValid())
+			{
+				Item.Body = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(FBlueprintSerializer::Encode(*Item.Snapshot));
+			}
+		});
+		const double EncodeSeconds = FPlatformTime::Seconds() - EncodeStart;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Items, RequestCopy = MoveTemp(RequestCopy), OnComplete, bCompactBinary, Format, CaptureSeconds, EncodeSeconds, CaptureCount]()
+		{
+			TSharedPtr<FHttpServerHandler> This = WeakThis.Pin();
+			if (!This.IsValid())
+			{
+				return;
+			}
+
+			for (FBatchItem& Item : *Items)
+			{
+				if (Item.Snapshot.IsValid())
+				{
+					Item.Serializer->AdoptEncodedNodes(*Item.Snapshot, Item.Body->Num());
+					This->ExportCache.Add(Item.Path, Format, Item.Revision, Item.Body.ToSharedRef());
+				}
+			}
+
+			// Items with errors are reported in place; the batch as a whole still succeeds
+			TArray<uint8> Body;
+			if (bCompactBinary)
+			{
+				FBlueprintCbWriter Writer;
+				Writer.WriteObjectStart();
+				Writer.WriteArrayStart(TEXT("blueprints"));
+				for (const FBatchItem& Entry : *Items)
+				{
+					const FBatchItem& Item = Entry.SameAs == INDEX_NONE ? Entry : (*Items)[Entry.SameAs];
+					Writer.WriteObjectStart();
+					Writer.WriteValue(TEXT("name"), Entry.Name);
+					Writer.WriteValue(TEXT("status"), Item.Status);
+					if (Item.Status == 200)
+					{
+						Writer.WriteValue(TEXT("etag"), Item.ETag);
+						Writer.WriteObject(TEXT("blueprint"), FCbFieldView(Item.Body->GetData()).AsObjectView());
+					}
+					else
+					{
+						Writer.WriteValue(TEXT("error"), Item.Error);
+					}
+					Writer.WriteObjectEnd();
+				}
+				Writer.WriteArrayEnd();
+				Writer.WriteObjectEnd();
+				Body = Writer.Save();
+			}
+			else
+			{
+				int64 TotalSize = 64;
+				for (const FBatchItem& Item : *Items)
+				{
+					TotalSize += (Item.Body.IsValid() ? Item.Body->Num() : 0) + 128;
+				}
+				Body.Reserve(TotalSize);
+
+				auto AppendLiteral = [&Body](const ANSICHAR* Literal)
+				{
+					Body.Append(reinterpret_cast<const uint8*>(Literal), FCStringAnsi::Strlen(Literal));
+				};
+
+				AppendLiteral("{\"blueprints\":[");
+				for (int32 Index = 0; Index < Items->Num(); ++Index)
+				{
+					const FBatchItem& Entry = (*Items)[Index];
+					const FBatchItem& Item = Entry.SameAs == INDEX_NONE ? Entry : (*Items)[Entry.SameAs];
+					if (Index > 0)
+					{
+						AppendLiteral(",");
+					}
+
+					TArray<uint8> Header;
+					FMemoryWriter Archive(Header);
+					TSharedRef<FBlueprintSerializer::FUtf8JsonWriter> Writer = FBlueprintSerializer::FUtf8JsonWriter::Create(&Archive);
+					Writer->WriteObjectStart();
+					Writer->WriteValue(TEXT("name"), Entry.Name);
+					Writer->WriteValue(TEXT("status"), Item.Status);
+					if (Item.Status == 200)
+					{
+						Writer->WriteValue(TEXT("etag"), Item.ETag);
+					}
+					else
+					{
+						Writer->WriteValue(TEXT("error"), Item.Error);
+					}
+					Writer->WriteObjectEnd();
+					Writer->Close();
+
+					if (Item.Status != 200)
+					{
+						Body.Append(Header);
+						continue;
+					}
+
+					// Reopen the condensed header object and splice the export bytes in as-is, without re-parsing them
+					Header.Pop();
+					Body.Append(Header);
+					AppendLiteral(",\"blueprint\":");
+					Body.Append(*Item.Body);
+					AppendLiteral("}");
+				}
+				AppendLiteral("]}");
+			}
+
+			UE_LOG(LogTemp, Verbose, TEXT("BlueprintAIBridge: Batch export of %d blueprints (%d captured): capture %.2f ms on game thread, encode %.2f ms in parallel, %d bytes"),
+				Items->Num(), CaptureCount, CaptureSeconds * 1000.0, EncodeSeconds * 1000.0, Body.Num());
+
+			SendResponse(RequestCopy, OnComplete, MoveTemp(Body), bCompactBinary ? CompactBinaryContentType : TEXT("application/json"));
+		});
+	});
+	return true;
 }
@@ -0,0 +1,196 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BlueprintBridgeTestFixture.h"
+#include "BlueprintCompileQueue.h"
+#include "BlueprintDeserializer.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+namespace BlueprintApplyPerfTest
+{
+	/** A NodeAdded delta for a Print String node, as the agent sends one edit at a time */
+	static FBlueprintDeltaData MakeNodeAdded(int32 Index)
+	{
+		FBlueprintDeltaData Delta;
+		Delta.Type = TEXT("NodeAdded");
+		FBlueprintNodeData& Node = Delta.Node.Emplace();
+		Node.Id = FGuid::NewDeterministicGuid(FString::Printf(TEXT("BlueprintApplyPerfTest.Node.%d"), Index)).ToString(EGuidFormats::DigitsWithHyphensLower);
+		Node.Title = TEXT("Print String");
+		Node.Style = TEXT("Function");
+		Node.PosX = Index * 300;
+		Node.PosY = 2000;
+		return Delta;
+	}
+
+	/** Variable types both paths of the skeleton benchmark can express, by bridge name and by K2 pin category */
+	static const TPair<const TCHAR*, FName> VariableTypes[] =
+	{
+		{ TEXT("Bool"), UEdGraphSchema_K2::PC_Boolean },
+		{ TEXT("Int"), UEdGraphSchema_K2::PC_Int },
+		{ TEXT("String"), UEdGraphSchema_K2::PC_String },
+		{ TEXT("Name"), UEdGraphSchema_K2::PC_Name },
+	};
+
+	static FString MakeVariableName(int32 Index)
+	{
+		return FString::Printf(TEXT("SkeletonVar%d"), Index);
+	}
+
+	/** Count variables, each read by a Get node and written by a Set node */
+	static FBlueprintStateData MakeVariableState(int32 Count)
+	{
+		FBlueprintStateData State;
+		State.bHasVariables = true;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FBlueprintVariableData& Variable = State.Variables.AddDefaulted_GetRef();
+			Variable.Id = FGuid::NewDeterministicGuid(FString::Printf(TEXT("BlueprintApplyPerfTest.Variable.%d"), Index)).ToString(EGuidFormats::DigitsWithHyphensLower);
+			Variable.Name = MakeVariableName(Index);
+			Variable.Type = VariableTypes[Index % UE_ARRAY_COUNT(VariableTypes)].Key;
+
+			for (const TCHAR* Prefix : { TEXT("Get "), TEXT("Set ") })
+			{
+				FBlueprintNodeData& Node = State.Nodes.AddDefaulted_GetRef();
+				Node.Id = FGuid::NewDeterministicGuid(FString::Printf(TEXT("BlueprintApplyPerfTest.VariableNode.%s%d"), Prefix, Index)).ToString(EGuidFormats::DigitsWithHyphensLower);
+				Node.Title = FString(Prefix) + Variable.Name;
+				Node.Style = TEXT("Variable");
+				Node.PosX = Index * 300;
+				Node.PosY = Prefix[0] == TEXT('S') ? 200 : 0;
+			}
+		}
+		return State;
+	}
+
+	/**
+	 * The construction the batched session replaced: AddMemberVariable per variable and a structural modification
+	 * per variable node, each of which regenerates the skeleton class
+	 */
+	static void BuildPerNode(UBlueprint* Blueprint, int32 Count)
+	{
+		UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FEdGraphPinType PinType;
+			PinType.PinCategory = VariableTypes[Index % UE_ARRAY_COUNT(VariableTypes)].Value;
+			FBlueprintEditorUtils::AddMemberVariable(Blueprint, FName(*MakeVariableName(Index)), PinType);
+		}
+
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FName VarName(*MakeVariableName(Index));
+
+			UK2Node_VariableGet* GetNode = NewObject<UK2Node_VariableGet>(Graph);
+			GetNode->CreateNewGuid();
+			GetNode->VariableReference.SetSelfMember(VarName);
+			GetNode->PostPlacedNewNode();
+			Graph->AddNode(GetNode, false, false);
+			GetNode->AllocateDefaultPins();
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+
+			UK2Node_VariableSet* SetNode = NewObject<UK2Node_VariableSet>(Graph);
+			SetNode->CreateNewGuid();
+			SetNode->VariableReference.SetSelfMember(VarName);
+			SetNode->PostPlacedNewNode();
+			Graph->AddNode(SetNode, false, false);
+			SetNode->AllocateDefaultPins();
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintCompileQueuePerfTest, "BlueprintAIBridge.Perf.Apply.CompileQueue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBlueprintCompileQueuePerfTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 FixtureNodes = 200;
+	static constexpr int32 Edits = 10;
+
+	UBlueprint* PerEdit = BlueprintBridgeTest::CreateChainBlueprint(TEXT("CompilePerEditFixture"), FixtureNodes);
+	UBlueprint* Queued = BlueprintBridgeTest::CreateChainBlueprint(TEXT("CompileQueuedFixture"), FixtureNodes);
+	if (!TestNotNull(TEXT("per-edit fixture"), PerEdit) || !TestNotNull(TEXT("queued fixture"), Queued))
+	{
+		return false;
+	}
+
+	// Separate queues, so the per-edit blueprint's leftover dirty mark can't ride along in the queued compile
+	FBlueprintCompileQueue PerEditCompiles;
+	FBlueprintDeserializer PerEditDeserializer(PerEditCompiles);
+	FBlueprintCompileQueue Compiles;
+	FBlueprintDeserializer Deserializer(Compiles);
+
+	// Neither measurement should pay for the first compile of its fixture
+	Compiles.CompileNow({ PerEdit, Queued });
+
+	// Before: every apply ended in a compile
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Edit = 0; Edit < Edits; ++Edit)
+	{
+		TestTrue(TEXT("per-edit apply"), PerEditDeserializer.ApplyDelta(PerEdit, BlueprintApplyPerfTest::MakeNodeAdded(Edit)));
+		FKismetEditorUtilities::CompileBlueprint(PerEdit);
+	}
+	const double PerEditSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// After: the edits only mark the blueprint dirty, and asking for results compiles it once
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Edit = 0; Edit < Edits; ++Edit)
+	{
+		TestTrue(TEXT("queued apply"), Deserializer.ApplyDelta(Queued, BlueprintApplyPerfTest::MakeNodeAdded(Edit)));
+	}
+	TestTrue(TEXT("edits leave the blueprint pending"), Compiles.IsPending(Queued));
+	const TArray<FBlueprintCompileResult> Results = Compiles.CompileNow({ Queued });
+	const double QueuedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TestFalse(TEXT("queued blueprint compiles cleanly"), Results[0].HasErrors());
+	TestFalse(TEXT("compile leaves nothing pending"), Compiles.IsPending(Queued));
+
+	AddInfo(FString::Printf(TEXT("%d edits to a %d-node blueprint: compile per edit %.2f ms, queued %.2f ms (%.1fx faster)"),
+		Edits, FixtureNodes, PerEditSeconds * 1000.0, QueuedSeconds * 1000.0, QueuedSeconds > 0.0 ? PerEditSeconds / QueuedSeconds : 0.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintSkeletonRegenerationPerfTest, "BlueprintAIBridge.Perf.Apply.VariableNodes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBlueprintSkeletonRegenerationPerfTest::RunTest(const FString& Parameters)
+{
+	// The per-node cost of the old path grows with the skeleton, so the gap widens with the variable count
+	static const int32 VariableCounts[] = { 50, 200 };
+
+	for (const int32 Count : VariableCounts)
+	{
+		UBlueprint* PerNode = BlueprintBridgeTest::CreateTransientBlueprint(TEXT("SkeletonPerNodeFixture"));
+		UBlueprint* Batched = BlueprintBridgeTest::CreateTransientBlueprint(TEXT("SkeletonBatchedFixture"));
+		if (!TestNotNull(TEXT("per-node fixture"), PerNode) || !TestNotNull(TEXT("batched fixture"), Batched))
+		{
+			return false;
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		BlueprintApplyPerfTest::BuildPerNode(PerNode, Count);
+		const double PerNodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		FBlueprintCompileQueue Compiles;
+		FBlueprintDeserializer Deserializer(Compiles);
+		const FBlueprintStateData State = BlueprintApplyPerfTest::MakeVariableState(Count);
+		StartTime = FPlatformTime::Seconds();
+		const bool bApplied = Deserializer.ApplyFullSync(Batched, State);
+		const double BatchedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TestTrue(FString::Printf(TEXT("%d-variable full sync"), Count), bApplied);
+		TestEqual(FString::Printf(TEXT("%d-variable full sync adds every variable"), Count), Batched->NewVariables.Num(), Count);
+
+		AddInfo(FString::Printf(TEXT("%d variables, %d Get/Set nodes: regenerate per node %.2f ms, batched full sync %.2f ms (%.1fx faster)"),
+			Count, Count * 2, PerNodeSeconds * 1000.0, BatchedSeconds * 1000.0, BatchedSeconds > 0.0 ? PerNodeSeconds / BatchedSeconds : 0.0));
+	}
+	return true;
+}
+
+#endif
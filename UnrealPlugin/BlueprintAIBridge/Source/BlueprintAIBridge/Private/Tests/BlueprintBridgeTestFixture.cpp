@@ -0,0 +1,102 @@
+#include "BlueprintBridgeTestFixture.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BlueprintCompileQueue.h"
+#include "BlueprintDeserializer.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/Package.h"
+
+namespace BlueprintBridgeTest
+{
+	static FString MakeFixtureId(const TCHAR* Kind, int32 Index)
+	{
+		return FGuid::NewDeterministicGuid(FString::Printf(TEXT("BlueprintBridgeTest.%s.%d"), Kind, Index))
+			.ToString(EGuidFormats::DigitsWithHyphensLower);
+	}
+
+	UBlueprint* CreateTransientBlueprint(const TCHAR* BaseName)
+	{
+		const FName Name = MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), FName(BaseName));
+		return FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), GetTransientPackage(), Name, BPTYPE_Normal,
+			UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	}
+
+	FBlueprintStateData MakeChainState(int32 NodeCount, int32 VariableCount)
+	{
+		static const TCHAR* VariableTypes[] = { TEXT("Bool"), TEXT("Int"), TEXT("Float"), TEXT("String"), TEXT("Name") };
+
+		FBlueprintStateData State;
+		State.Name = TEXT("ChainFixture");
+		State.Nodes.Reserve(NodeCount);
+		State.Connections.Reserve(FMath::Max(NodeCount - 1, 0));
+
+		for (int32 Index = 0; Index < NodeCount; ++Index)
+		{
+			FBlueprintNodeData& Node = State.Nodes.AddDefaulted_GetRef();
+			Node.Id = MakeFixtureId(TEXT("Node"), Index);
+			Node.PosX = (Index % 100) * 300;
+			Node.PosY = (Index / 100) * 200;
+			if (Index == 0)
+			{
+				Node.Title = TEXT("Event BeginPlay");
+				Node.Style = TEXT("Event");
+			}
+			else if (Index % 2 == 1)
+			{
+				Node.Title = TEXT("Print String");
+				Node.Style = TEXT("Function");
+			}
+			else
+			{
+				Node.Title = TEXT("Branch");
+				Node.Style = TEXT("FlowControl");
+			}
+
+			// Exec pins are resolved by type, so the links need no pin IDs
+			if (Index > 0)
+			{
+				FBlueprintConnectionData& Connection = State.Connections.AddDefaulted_GetRef();
+				Connection.Id = MakeFixtureId(TEXT("Connection"), Index);
+				Connection.SourceNodeId = State.Nodes[Index - 1].Id;
+				Connection.TargetNodeId = Node.Id;
+				Connection.PinType = TEXT("Exec");
+			}
+		}
+
+		State.bHasVariables = true;
+		for (int32 Index = 0; Index < VariableCount; ++Index)
+		{
+			FBlueprintVariableData& Variable = State.Variables.AddDefaulted_GetRef();
+			Variable.Id = MakeFixtureId(TEXT("Variable"), Index);
+			Variable.Name = FString::Printf(TEXT("FixtureVar%d"), Index);
+			Variable.Type = VariableTypes[Index % UE_ARRAY_COUNT(VariableTypes)];
+			Variable.Category = TEXT("Fixture");
+			Variable.bIsEditable = Index % 2 == 0;
+		}
+		return State;
+	}
+
+	UBlueprint* CreateChainBlueprint(const TCHAR* BaseName, int32 NodeCount, int32 VariableCount)
+	{
+		UBlueprint* Blueprint = CreateTransientBlueprint(BaseName);
+		if (!Blueprint)
+		{
+			return nullptr;
+		}
+
+		// The queue goes away with this scope, so the fixture is never compiled behind the test's back
+		FBlueprintCompileQueue Compiles;
+		FBlueprintDeserializer Deserializer(Compiles);
+		if (!Deserializer.ApplyFullSync(Blueprint, MakeChainState(NodeCount, VariableCount)))
+		{
+			return nullptr;
+		}
+		return Blueprint;
+	}
+}
+
+#endif
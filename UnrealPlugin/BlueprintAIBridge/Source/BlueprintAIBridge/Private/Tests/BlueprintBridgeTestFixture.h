@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BlueprintData.h"
+
+class UBlueprint;
+
+/** Blueprints and payloads shared by the bridge's automation tests */
+namespace BlueprintBridgeTest
+{
+	/** A new Actor blueprint in the transient package, collected by the next GC once nothing references it */
+	UBlueprint* CreateTransientBlueprint(const TCHAR* BaseName);
+
+	/**
+	 * A BeginPlay event followed by NodeCount - 1 nodes alternating Print String and Branch, chained exec to exec,
+	 * plus VariableCount member variables. IDs are derived from the indices, so equal arguments give equal payloads.
+	 */
+	FBlueprintStateData MakeChainState(int32 NodeCount, int32 VariableCount = 4);
+
+	/** A transient blueprint holding MakeChainState(NodeCount, VariableCount), built by the deserializer's full sync */
+	UBlueprint* CreateChainBlueprint(const TCHAR* BaseName, int32 NodeCount, int32 VariableCount = 4);
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BlueprintBridgeTestFixture.h"
+#include "BlueprintSerializer.h"
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace BlueprintExportPerfTest
+{
+	/** Repetitions per measurement; the fastest one is reported, which filters out GC and scheduler noise */
+	static constexpr int32 Runs = 3;
+
+	/** Cold export (new serializer, empty fragment cache) of Blueprint; returns capture + encode seconds of the fastest run */
+	static double TimeColdExport(UBlueprint* Blueprint, double& OutCaptureSeconds, double& OutEncodeSeconds)
+	{
+		double Best = TNumericLimits<double>::Max();
+		for (int32 Run = 0; Run < Runs; ++Run)
+		{
+			TSharedRef<FBlueprintSerializer> Serializer = MakeShared<FBlueprintSerializer>();
+			TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Snapshot = Serializer->Capture(Blueprint, EBlueprintWireFormat::Json);
+			FBlueprintSerializer::Encode(*Snapshot);
+			if (Snapshot->CaptureSeconds + Snapshot->EncodeSeconds < Best)
+			{
+				Best = Snapshot->CaptureSeconds + Snapshot->EncodeSeconds;
+				OutCaptureSeconds = Snapshot->CaptureSeconds;
+				OutEncodeSeconds = Snapshot->EncodeSeconds;
+			}
+		}
+		return Best;
+	}
+
+	static TSharedRef<FJsonObject> MakePinObject(const FBlueprintPinData& Pin, const TCHAR* Direction)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("id"), Pin.Id);
+		Object->SetStringField(TEXT("name"), Pin.Name);
+		Object->SetStringField(TEXT("type"), Pin.Type);
+		Object->SetStringField(TEXT("direction"), Direction);
+		Object->SetBoolField(TEXT("isConnected"), Pin.bIsConnected);
+		if (Pin.bHasDefaultValue)
+		{
+			Object->SetStringField(TEXT("defaultValue"), Pin.DefaultValue);
+		}
+		if (!Pin.SubType.IsEmpty())
+		{
+			Object->SetStringField(TEXT("subType"), Pin.SubType);
+		}
+		return Object;
+	}
+
+	/** The export as the DOM-based serializer built it: one FJsonObject per node, pin, connection and variable */
+	static TSharedRef<FJsonObject> MakeExportDom(const FBlueprintExportSnapshot& Snapshot)
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("name"), Snapshot.Name);
+
+		TArray<TSharedPtr<FJsonValue>> Nodes;
+		for (const FBlueprintExportSnapshot::FNode& Node : Snapshot.Nodes)
+		{
+			const FBlueprintNodeData& Data = Node.Data.GetValue();
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("id"), Data.Id);
+			Object->SetStringField(TEXT("title"), Data.Title);
+			Object->SetStringField(TEXT("category"), Data.Category);
+			Object->SetStringField(TEXT("style"), Data.Style);
+			Object->SetNumberField(TEXT("positionX"), Data.PosX);
+			Object->SetNumberField(TEXT("positionY"), Data.PosY);
+			Object->SetBoolField(TEXT("isCompact"), Data.bIsCompact);
+
+			TArray<TSharedPtr<FJsonValue>> InputPins;
+			for (const FBlueprintPinData& Pin : Data.InputPins)
+			{
+				InputPins.Add(MakeShared<FJsonValueObject>(MakePinObject(Pin, TEXT("Input"))));
+			}
+			Object->SetArrayField(TEXT("inputPins"), InputPins);
+
+			TArray<TSharedPtr<FJsonValue>> OutputPins;
+			for (const FBlueprintPinData& Pin : Data.OutputPins)
+			{
+				OutputPins.Add(MakeShared<FJsonValueObject>(MakePinObject(Pin, TEXT("Output"))));
+			}
+			Object->SetArrayField(TEXT("outputPins"), OutputPins);
+
+			Nodes.Add(MakeShared<FJsonValueObject>(Object));
+		}
+		Root->SetArrayField(TEXT("nodes"), Nodes);
+
+		TArray<TSharedPtr<FJsonValue>> Connections;
+		for (const FBlueprintConnectionData& Connection : Snapshot.Connections)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("id"), Connection.Id);
+			Object->SetStringField(TEXT("sourceNodeId"), Connection.SourceNodeId);
+			Object->SetStringField(TEXT("sourcePinId"), Connection.SourcePinId);
+			Object->SetStringField(TEXT("targetNodeId"), Connection.TargetNodeId);
+			Object->SetStringField(TEXT("targetPinId"), Connection.TargetPinId);
+			Object->SetStringField(TEXT("pinType"), Connection.PinType);
+			Connections.Add(MakeShared<FJsonValueObject>(Object));
+		}
+		Root->SetArrayField(TEXT("connections"), Connections);
+		Root->SetArrayField(TEXT("comments"), TArray<TSharedPtr<FJsonValue>>());
+
+		TArray<TSharedPtr<FJsonValue>> Variables;
+		for (const FBlueprintVariableData& Variable : Snapshot.Variables)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("id"), Variable.Id);
+			Object->SetStringField(TEXT("name"), Variable.Name);
+			Object->SetStringField(TEXT("type"), Variable.Type);
+			if (!Variable.DefaultValue.IsEmpty())
+			{
+				Object->SetStringField(TEXT("defaultValue"), Variable.DefaultValue);
+			}
+			Object->SetStringField(TEXT("category"), Variable.Category);
+			Object->SetBoolField(TEXT("isEditable"), Variable.bIsEditable);
+			Variables.Add(MakeShared<FJsonValueObject>(Object));
+		}
+		Root->SetArrayField(TEXT("variables"), Variables);
+		return Root;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintExportScalingPerfTest, "BlueprintAIBridge.Perf.Export.Scaling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBlueprintExportScalingPerfTest::RunTest(const FString& Parameters)
+{
+	// Export should cost the same per node at every size; the old connection pass scanned the pin map per link
+	static const int32 NodeCounts[] = { 100, 1000, 10000, 50000 };
+
+	double SmallestMicrosPerNode = 0.0;
+	double LargestMicrosPerNode = 0.0;
+	for (const int32 NodeCount : NodeCounts)
+	{
+		UBlueprint* Blueprint = BlueprintBridgeTest::CreateChainBlueprint(TEXT("ExportScalingFixture"), NodeCount);
+		if (!TestNotNull(FString::Printf(TEXT("%d-node fixture"), NodeCount), Blueprint))
+		{
+			return false;
+		}
+
+		double CaptureSeconds = 0.0;
+		double EncodeSeconds = 0.0;
+		const double Seconds = BlueprintExportPerfTest::TimeColdExport(Blueprint, CaptureSeconds, EncodeSeconds);
+		const double MicrosPerNode = Seconds * 1e6 / NodeCount;
+		AddInfo(FString::Printf(TEXT("%6d nodes: %9.2f ms (capture %.2f ms, encode %.2f ms), %.2f us/node"),
+			NodeCount, Seconds * 1000.0, CaptureSeconds * 1000.0, EncodeSeconds * 1000.0, MicrosPerNode));
+
+		// The 100-node run is dominated by fixed costs, so linearity is judged from 1k nodes up
+		if (NodeCount == 1000)
+		{
+			SmallestMicrosPerNode = MicrosPerNode;
+		}
+		LargestMicrosPerNode = MicrosPerNode;
+	}
+
+	const double Growth = SmallestMicrosPerNode > 0.0 ? LargestMicrosPerNode / SmallestMicrosPerNode : 0.0;
+	AddInfo(FString::Printf(TEXT("Per-node cost at %d nodes is %.2fx the cost at 1000 nodes"), NodeCounts[UE_ARRAY_COUNT(NodeCounts) - 1], Growth));
+	if (Growth > 3.0)
+	{
+		AddWarning(TEXT("Export cost per node grows with graph size; the export is no longer linear-time"));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintExportStreamingPerfTest, "BlueprintAIBridge.Perf.Export.StreamingVsDom",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBlueprintExportStreamingPerfTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NodeCount = 10000;
+
+	UBlueprint* Blueprint = BlueprintBridgeTest::CreateChainBlueprint(TEXT("ExportStreamingFixture"), NodeCount);
+	if (!TestNotNull(TEXT("fixture blueprint"), Blueprint))
+	{
+		return false;
+	}
+
+	// Both paths encode the same cold capture, so the difference is the encoding alone
+	double DomSeconds = TNumericLimits<double>::Max();
+	double StreamSeconds = TNumericLimits<double>::Max();
+	int64 DomTransientBytes = 0;
+	int64 StreamBytes = 0;
+	for (int32 Run = 0; Run < BlueprintExportPerfTest::Runs; ++Run)
+	{
+		TSharedRef<FBlueprintSerializer> Serializer = MakeShared<FBlueprintSerializer>();
+		TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Snapshot = Serializer->Capture(Blueprint, EBlueprintWireFormat::Json);
+		if (!TestEqual(TEXT("cold capture re-encodes every node"), Snapshot->CapturedNodeCount, Snapshot->Nodes.Num()))
+		{
+			return false;
+		}
+
+		// Before: DOM, then a UTF-16 FString, then the UTF-8 copy the response body is made of
+		double StartTime = FPlatformTime::Seconds();
+		FString Text;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+		FJsonSerializer::Serialize(BlueprintExportPerfTest::MakeExportDom(*Snapshot), Writer);
+		FTCHARToUTF8 Utf8(*Text, Text.Len());
+		TArray<uint8> DomBody(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		DomSeconds = FMath::Min(DomSeconds, FPlatformTime::Seconds() - StartTime);
+		DomTransientBytes = Text.GetAllocatedSize() + Utf8.Length() + DomBody.GetAllocatedSize();
+
+		// After: straight into the UTF-8 body
+		StartTime = FPlatformTime::Seconds();
+		const TArray<uint8> StreamBody = FBlueprintSerializer::Encode(*Snapshot);
+		StreamSeconds = FMath::Min(StreamSeconds, FPlatformTime::Seconds() - StartTime);
+		StreamBytes = StreamBody.GetAllocatedSize();
+	}
+
+	AddInfo(FString::Printf(TEXT("%d nodes, DOM + FString + UTF-8 copy: %.2f ms, %lld bytes of text buffers"),
+		NodeCount, DomSeconds * 1000.0, DomTransientBytes));
+	AddInfo(FString::Printf(TEXT("%d nodes, streaming UTF-8 writer: %.2f ms, %lld bytes of text buffers (%.1fx faster)"),
+		NodeCount, StreamSeconds * 1000.0, StreamBytes, StreamSeconds > 0.0 ? DomSeconds / StreamSeconds : 0.0));
+	if (StreamSeconds > DomSeconds)
+	{
+		AddWarning(TEXT("The streaming export is slower than building and printing a JSON DOM"));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,208 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BlueprintBridgeTestFixture.h"
+#include "BlueprintJsonReader.h"
+#include "BlueprintSerializer.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace BlueprintParsePerfTest
+{
+	static constexpr int32 Runs = 3;
+
+	static FString GetStringOrEmpty(const FJsonObject& Object, const TCHAR* Field)
+	{
+		FString Value;
+		Object.TryGetStringField(Field, Value);
+		return Value;
+	}
+
+	static void ReadPinsFromDom(const FJsonObject& Node, const TCHAR* Field, TArray<FBlueprintPinData>& OutPins)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Pins = nullptr;
+		if (!Node.TryGetArrayField(Field, Pins))
+		{
+			return;
+		}
+		for (const TSharedPtr<FJsonValue>& Value : *Pins)
+		{
+			const TSharedPtr<FJsonObject>* Object = nullptr;
+			if (!Value->TryGetObject(Object))
+			{
+				continue;
+			}
+			FBlueprintPinData& Pin = OutPins.AddDefaulted_GetRef();
+			Pin.Id = GetStringOrEmpty(**Object, TEXT("id"));
+			Pin.Name = GetStringOrEmpty(**Object, TEXT("name"));
+			Pin.Type = GetStringOrEmpty(**Object, TEXT("type"));
+			Pin.SubType = GetStringOrEmpty(**Object, TEXT("subType"));
+			Pin.bHasDefaultValue = (*Object)->TryGetStringField(TEXT("defaultValue"), Pin.DefaultValue);
+			(*Object)->TryGetBoolField(TEXT("isConnected"), Pin.bIsConnected);
+		}
+	}
+
+	/** The pre-streaming route: transcode the body to UTF-16, build the DOM, then walk it field by field */
+	static bool ParseWithDom(const TArray<uint8>& Body, FBlueprintStateData& OutState)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		const FString Text(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+		{
+			return false;
+		}
+
+		// A FullSync delta carries the state under "fullState"; a raw state is the body itself
+		const TSharedPtr<FJsonObject>* FullState = nullptr;
+		const FJsonObject& State = Root->TryGetObjectField(TEXT("fullState"), FullState) ? **FullState : *Root;
+		OutState.Name = GetStringOrEmpty(State, TEXT("name"));
+
+		const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+		if (State.TryGetArrayField(TEXT("nodes"), Nodes))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Nodes)
+			{
+				const TSharedPtr<FJsonObject>* Object = nullptr;
+				if (!Value->TryGetObject(Object))
+				{
+					continue;
+				}
+				FBlueprintNodeData& Node = OutState.Nodes.AddDefaulted_GetRef();
+				Node.Id = GetStringOrEmpty(**Object, TEXT("id"));
+				Node.Title = GetStringOrEmpty(**Object, TEXT("title"));
+				Node.Category = GetStringOrEmpty(**Object, TEXT("category"));
+				Node.Style = GetStringOrEmpty(**Object, TEXT("style"));
+				(*Object)->TryGetNumberField(TEXT("positionX"), Node.PosX);
+				(*Object)->TryGetNumberField(TEXT("positionY"), Node.PosY);
+				(*Object)->TryGetBoolField(TEXT("isCompact"), Node.bIsCompact);
+				ReadPinsFromDom(**Object, TEXT("inputPins"), Node.InputPins);
+				ReadPinsFromDom(**Object, TEXT("outputPins"), Node.OutputPins);
+			}
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Connections = nullptr;
+		if (State.TryGetArrayField(TEXT("connections"), Connections))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Connections)
+			{
+				const TSharedPtr<FJsonObject>* Object = nullptr;
+				if (!Value->TryGetObject(Object))
+				{
+					continue;
+				}
+				FBlueprintConnectionData& Connection = OutState.Connections.AddDefaulted_GetRef();
+				Connection.Id = GetStringOrEmpty(**Object, TEXT("id"));
+				Connection.SourceNodeId = GetStringOrEmpty(**Object, TEXT("sourceNodeId"));
+				Connection.SourcePinId = GetStringOrEmpty(**Object, TEXT("sourcePinId"));
+				Connection.TargetNodeId = GetStringOrEmpty(**Object, TEXT("targetNodeId"));
+				Connection.TargetPinId = GetStringOrEmpty(**Object, TEXT("targetPinId"));
+				Connection.PinType = GetStringOrEmpty(**Object, TEXT("pinType"));
+			}
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Variables = nullptr;
+		OutState.bHasVariables = State.TryGetArrayField(TEXT("variables"), Variables);
+		if (OutState.bHasVariables)
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Variables)
+			{
+				const TSharedPtr<FJsonObject>* Object = nullptr;
+				if (!Value->TryGetObject(Object))
+				{
+					continue;
+				}
+				FBlueprintVariableData& Variable = OutState.Variables.AddDefaulted_GetRef();
+				Variable.Id = GetStringOrEmpty(**Object, TEXT("id"));
+				Variable.Name = GetStringOrEmpty(**Object, TEXT("name"));
+				Variable.Type = GetStringOrEmpty(**Object, TEXT("type"));
+				Variable.DefaultValue = GetStringOrEmpty(**Object, TEXT("defaultValue"));
+				Variable.Category = GetStringOrEmpty(**Object, TEXT("category"));
+				(*Object)->TryGetBoolField(TEXT("isEditable"), Variable.bIsEditable);
+			}
+		}
+		return true;
+	}
+
+	/** Payloads to parse: a generated 10k-node export, plus any recorded bodies saved under Saved/BlueprintAIBridge/Payloads */
+	static void GatherPayloads(TArray<TPair<FString, TArray<uint8>>>& OutPayloads)
+	{
+		if (UBlueprint* Blueprint = BlueprintBridgeTest::CreateChainBlueprint(TEXT("ParseFixture"), 10000))
+		{
+			TSharedRef<FBlueprintSerializer> Serializer = MakeShared<FBlueprintSerializer>();
+			OutPayloads.Emplace(TEXT("generated 10k-node export"), Serializer->SerializeBlueprint(Blueprint));
+		}
+
+		const FString RecordedDir = FPaths::ProjectSavedDir() / TEXT("BlueprintAIBridge") / TEXT("Payloads");
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(RecordedDir / TEXT("*.json")), true, false);
+		for (const FString& File : Files)
+		{
+			TArray<uint8> Body;
+			if (FFileHelper::LoadFileToArray(Body, *(RecordedDir / File)))
+			{
+				OutPayloads.Emplace(File, MoveTemp(Body));
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintParsePerfTest, "BlueprintAIBridge.Perf.Parse.StreamingVsDom",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBlueprintParsePerfTest::RunTest(const FString& Parameters)
+{
+	TArray<TPair<FString, TArray<uint8>>> Payloads;
+	BlueprintParsePerfTest::GatherPayloads(Payloads);
+	if (!TestTrue(TEXT("at least one payload to parse"), Payloads.Num() > 0))
+	{
+		return false;
+	}
+
+	for (const TPair<FString, TArray<uint8>>& Payload : Payloads)
+	{
+		double DomSeconds = TNumericLimits<double>::Max();
+		double StreamSeconds = TNumericLimits<double>::Max();
+		FBlueprintStateData DomState;
+		FBlueprintDeltaData StreamDelta;
+		for (int32 Run = 0; Run < BlueprintParsePerfTest::Runs; ++Run)
+		{
+			DomState = FBlueprintStateData();
+			double StartTime = FPlatformTime::Seconds();
+			const bool bDomParsed = BlueprintParsePerfTest::ParseWithDom(Payload.Value, DomState);
+			DomSeconds = FMath::Min(DomSeconds, FPlatformTime::Seconds() - StartTime);
+
+			StreamDelta = FBlueprintDeltaData();
+			StartTime = FPlatformTime::Seconds();
+			FBlueprintJsonReader Reader(Payload.Value);
+			const bool bStreamParsed = Reader.ReadDelta(StreamDelta);
+			StreamSeconds = FMath::Min(StreamSeconds, FPlatformTime::Seconds() - StartTime);
+
+			if (!TestTrue(FString::Printf(TEXT("%s parses with the DOM"), *Payload.Key), bDomParsed)
+				|| !TestTrue(FString::Printf(TEXT("%s parses with FBlueprintJsonReader (%s)"), *Payload.Key, *Reader.GetError()), bStreamParsed))
+			{
+				return false;
+			}
+		}
+
+		// Both parsers must have seen the same payload, or the timings compare different work
+		if (StreamDelta.FullState.IsSet())
+		{
+			TestEqual(FString::Printf(TEXT("%s node count"), *Payload.Key), StreamDelta.FullState->Nodes.Num(), DomState.Nodes.Num());
+			TestEqual(FString::Printf(TEXT("%s connection count"), *Payload.Key), StreamDelta.FullState->Connections.Num(), DomState.Connections.Num());
+		}
+
+		AddInfo(FString::Printf(TEXT("%s (%d KB): FJsonSerializer DOM %.2f ms, FBlueprintJsonReader %.2f ms (%.1fx faster)"),
+			*Payload.Key, Payload.Value.Num() / 1024, DomSeconds * 1000.0, StreamSeconds * 1000.0,
+			StreamSeconds > 0.0 ? DomSeconds / StreamSeconds : 0.0));
+	}
+	return true;
+}
+
+#endif
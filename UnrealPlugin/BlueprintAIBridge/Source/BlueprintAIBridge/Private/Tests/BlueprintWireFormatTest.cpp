@@ -0,0 +1,163 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BlueprintBridgeTestFixture.h"
+#include "BlueprintCbReader.h"
+#include "BlueprintJsonReader.h"
+#include "BlueprintSerializer.h"
+
+namespace BlueprintWireFormatTest
+{
+	static void ComparePins(FAutomationTestBase& Test, const FString& Context, const TArray<FBlueprintPinData>& Json, const TArray<FBlueprintPinData>& Cb)
+	{
+		if (!Test.TestEqual(Context + TEXT(" count"), Cb.Num(), Json.Num()))
+		{
+			return;
+		}
+		for (int32 Index = 0; Index < Json.Num(); ++Index)
+		{
+			const FString Pin = FString::Printf(TEXT("%s[%d]"), *Context, Index);
+			Test.TestEqual(Pin + TEXT(" id"), Cb[Index].Id, Json[Index].Id);
+			Test.TestEqual(Pin + TEXT(" name"), Cb[Index].Name, Json[Index].Name);
+			Test.TestEqual(Pin + TEXT(" type"), Cb[Index].Type, Json[Index].Type);
+			Test.TestEqual(Pin + TEXT(" subType"), Cb[Index].SubType, Json[Index].SubType);
+			Test.TestEqual(Pin + TEXT(" defaultValue"), Cb[Index].DefaultValue, Json[Index].DefaultValue);
+			Test.TestEqual(Pin + TEXT(" hasDefaultValue"), Cb[Index].bHasDefaultValue, Json[Index].bHasDefaultValue);
+			Test.TestEqual(Pin + TEXT(" isConnected"), Cb[Index].bIsConnected, Json[Index].bIsConnected);
+		}
+	}
+
+	/** Field-by-field, so a failure names the record and field the encodings disagree on */
+	static void CompareStates(FAutomationTestBase& Test, const FBlueprintStateData& Json, const FBlueprintStateData& Cb)
+	{
+		Test.TestEqual(TEXT("name"), Cb.Name, Json.Name);
+		Test.TestEqual(TEXT("hasVariables"), Cb.bHasVariables, Json.bHasVariables);
+
+		if (Test.TestEqual(TEXT("node count"), Cb.Nodes.Num(), Json.Nodes.Num()))
+		{
+			for (int32 Index = 0; Index < Json.Nodes.Num(); ++Index)
+			{
+				const FBlueprintNodeData& J = Json.Nodes[Index];
+				const FBlueprintNodeData& C = Cb.Nodes[Index];
+				const FString Node = FString::Printf(TEXT("nodes[%d]"), Index);
+				Test.TestEqual(Node + TEXT(" id"), C.Id, J.Id);
+				Test.TestEqual(Node + TEXT(" title"), C.Title, J.Title);
+				Test.TestEqual(Node + TEXT(" category"), C.Category, J.Category);
+				Test.TestEqual(Node + TEXT(" style"), C.Style, J.Style);
+				Test.TestEqual(Node + TEXT(" posX"), C.PosX, J.PosX);
+				Test.TestEqual(Node + TEXT(" posY"), C.PosY, J.PosY);
+				Test.TestEqual(Node + TEXT(" isCompact"), C.bIsCompact, J.bIsCompact);
+				ComparePins(Test, Node + TEXT(".inputPins"), J.InputPins, C.InputPins);
+				ComparePins(Test, Node + TEXT(".outputPins"), J.OutputPins, C.OutputPins);
+			}
+		}
+
+		if (Test.TestEqual(TEXT("connection count"), Cb.Connections.Num(), Json.Connections.Num()))
+		{
+			for (int32 Index = 0; Index < Json.Connections.Num(); ++Index)
+			{
+				const FBlueprintConnectionData& J = Json.Connections[Index];
+				const FBlueprintConnectionData& C = Cb.Connections[Index];
+				const FString Connection = FString::Printf(TEXT("connections[%d]"), Index);
+				Test.TestEqual(Connection + TEXT(" id"), C.Id, J.Id);
+				Test.TestEqual(Connection + TEXT(" sourceNodeId"), C.SourceNodeId, J.SourceNodeId);
+				Test.TestEqual(Connection + TEXT(" sourcePinId"), C.SourcePinId, J.SourcePinId);
+				Test.TestEqual(Connection + TEXT(" targetNodeId"), C.TargetNodeId, J.TargetNodeId);
+				Test.TestEqual(Connection + TEXT(" targetPinId"), C.TargetPinId, J.TargetPinId);
+				Test.TestEqual(Connection + TEXT(" pinType"), C.PinType, J.PinType);
+			}
+		}
+
+		if (Test.TestEqual(TEXT("variable count"), Cb.Variables.Num(), Json.Variables.Num()))
+		{
+			for (int32 Index = 0; Index < Json.Variables.Num(); ++Index)
+			{
+				const FBlueprintVariableData& J = Json.Variables[Index];
+				const FBlueprintVariableData& C = Cb.Variables[Index];
+				const FString Variable = FString::Printf(TEXT("variables[%d]"), Index);
+				Test.TestEqual(Variable + TEXT(" id"), C.Id, J.Id);
+				Test.TestEqual(Variable + TEXT(" name"), C.Name, J.Name);
+				Test.TestEqual(Variable + TEXT(" type"), C.Type, J.Type);
+				Test.TestEqual(Variable + TEXT(" defaultValue"), C.DefaultValue, J.DefaultValue);
+				Test.TestEqual(Variable + TEXT(" category"), C.Category, J.Category);
+				Test.TestEqual(Variable + TEXT(" isEditable"), C.bIsEditable, J.bIsEditable);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintWireFormatConformanceTest, "BlueprintAIBridge.WireFormat.CompactBinaryMatchesJson",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBlueprintWireFormatConformanceTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = BlueprintBridgeTest::CreateChainBlueprint(TEXT("WireFormatFixture"), 12);
+	if (!TestNotNull(TEXT("fixture blueprint"), Blueprint))
+	{
+		return false;
+	}
+
+	// The second JSON export comes out of the fragment cache the first one filled, so it must match byte for byte
+	TSharedRef<FBlueprintSerializer> Serializer = MakeShared<FBlueprintSerializer>();
+	const TArray<uint8> JsonBody = Serializer->SerializeBlueprint(Blueprint, EBlueprintWireFormat::Json);
+	const TArray<uint8> CbBody = Serializer->SerializeBlueprint(Blueprint, EBlueprintWireFormat::CompactBinary);
+	const TArray<uint8> CachedJsonBody = Serializer->SerializeBlueprint(Blueprint, EBlueprintWireFormat::Json);
+	TestTrue(TEXT("cached JSON export matches the fresh one"), CachedJsonBody == JsonBody);
+
+	FBlueprintStateData JsonState;
+	FBlueprintJsonReader JsonReader(JsonBody);
+	const bool bJsonRead = JsonReader.ReadBlueprintState(JsonState);
+	if (!TestTrue(FString::Printf(TEXT("JSON export reads back (%s)"), *JsonReader.GetError()), bJsonRead))
+	{
+		return false;
+	}
+
+	FBlueprintDeltaData CbDelta;
+	FBlueprintCbReader CbReader(CbBody);
+	const bool bCbRead = CbReader.ReadDelta(CbDelta);
+	if (!TestTrue(FString::Printf(TEXT("Compact Binary export reads back (%s)"), *CbReader.GetError()), bCbRead)
+		|| !TestTrue(TEXT("Compact Binary export is a full state"), CbDelta.FullState.IsSet()))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("export holds the fixture nodes"), JsonState.Nodes.Num() >= 12);
+	TestTrue(TEXT("export holds the fixture links"), JsonState.Connections.Num() >= 11);
+	TestEqual(TEXT("export holds the fixture variables"), JsonState.Variables.Num(), 4);
+
+	BlueprintWireFormatTest::CompareStates(*this, JsonState, CbDelta.FullState.GetValue());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintJsonScalarDefaultsTest, "BlueprintAIBridge.WireFormat.ScalarDefaultValues",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBlueprintJsonScalarDefaultsTest::RunTest(const FString& Parameters)
+{
+	// Hand-written payloads give defaults as JSON numbers and bools rather than strings
+	const FTCHARToUTF8 Utf8(TEXT("{\"nodes\":[{\"id\":\"n\",\"inputPins\":[{\"name\":\"A\",\"defaultValue\":5},{\"name\":\"B\",\"defaultValue\":2.5},")
+		TEXT("{\"name\":\"C\",\"defaultValue\":true},{\"name\":\"D\",\"defaultValue\":null}]}],")
+		TEXT("\"variables\":[{\"name\":\"Health\",\"type\":\"Int\",\"defaultValue\":100}]}"));
+
+	FBlueprintStateData State;
+	FBlueprintJsonReader Reader(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()));
+	if (!TestTrue(FString::Printf(TEXT("payload reads (%s)"), *Reader.GetError()), Reader.ReadBlueprintState(State))
+		|| !TestEqual(TEXT("node count"), State.Nodes.Num(), 1) || !TestEqual(TEXT("pin count"), State.Nodes[0].InputPins.Num(), 4)
+		|| !TestEqual(TEXT("variable count"), State.Variables.Num(), 1))
+	{
+		return false;
+	}
+
+	const TArray<FBlueprintPinData>& Pins = State.Nodes[0].InputPins;
+	TestEqual(TEXT("integer default"), Pins[0].DefaultValue, FString(TEXT("5")));
+	TestEqual(TEXT("float default"), Pins[1].DefaultValue, FString(TEXT("2.5")));
+	TestEqual(TEXT("bool default"), Pins[2].DefaultValue, FString(TEXT("true")));
+	TestTrue(TEXT("scalar defaults count as set"), Pins[0].bHasDefaultValue && Pins[1].bHasDefaultValue && Pins[2].bHasDefaultValue);
+	TestFalse(TEXT("null default is unset"), Pins[3].bHasDefaultValue);
+	TestEqual(TEXT("variable default"), State.Variables[0].DefaultValue, FString(TEXT("100")));
+	return true;
+}
+
+#endif
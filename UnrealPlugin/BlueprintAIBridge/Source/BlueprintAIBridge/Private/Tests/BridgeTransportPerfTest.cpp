@@ -0,0 +1,286 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "HttpModule.h"
+#include "IWebSocket.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "WebSocketsModule.h"
+
+namespace BridgeTransportPerfTest
+{
+	/** Calls per measurement; status is the cheapest op, so the numbers are transport overhead */
+	static constexpr int32 Calls = 100;
+	static constexpr double TimeoutSeconds = 120.0;
+
+	/**
+	 * Drives the running bridge through both transports from inside the editor: sequential calls, then a burst
+	 * with every call in flight at once. Both clients deliver their completions on the game thread, so the
+	 * sequential numbers include the frame wait for either transport alike.
+	 */
+	class FLatencyProbe : public TSharedFromThis<FLatencyProbe>
+	{
+	public:
+		TArray<double> HttpSeconds;
+		TArray<double> WebSocketSeconds;
+		double HttpBurstSeconds = 0.0;
+		double WebSocketBurstSeconds = 0.0;
+		FString Error;
+
+		void Start()
+		{
+			SendHttp(false);
+		}
+
+		bool IsFinished() const
+		{
+			return bFinished;
+		}
+
+		/** The socket may be inside its own callback here, so it is only closed; it is deleted with the probe */
+		void Stop()
+		{
+			if (Socket.IsValid() && !bFinished)
+			{
+				Socket->Close();
+			}
+			bFinished = true;
+		}
+
+	private:
+		void Fail(const FString& Message)
+		{
+			if (!bFinished)
+			{
+				Error = Message;
+				Stop();
+			}
+		}
+
+		void SendHttp(bool bBurst)
+		{
+			TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+			Request->SetURL(TEXT("http://127.0.0.1:8089/api/status"));
+			Request->SetVerb(TEXT("GET"));
+
+			TWeakPtr<FLatencyProbe> WeakThis = AsShared();
+			const double SentAt = FPlatformTime::Seconds();
+			Request->OnProcessRequestComplete().BindLambda([WeakThis, SentAt, bBurst](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+			{
+				if (TSharedPtr<FLatencyProbe> This = WeakThis.Pin())
+				{
+					if (!bSucceeded || !Response.IsValid() || Response->GetResponseCode() != 200)
+					{
+						This->Fail(TEXT("GET /api/status failed; is the bridge listening on port 8089?"));
+						return;
+					}
+					This->OnHttpAnswered(FPlatformTime::Seconds() - SentAt, bBurst);
+				}
+			});
+			Request->ProcessRequest();
+		}
+
+		void OnHttpAnswered(double Seconds, bool bBurst)
+		{
+			if (bFinished)
+			{
+				return;
+			}
+			if (!bBurst)
+			{
+				HttpSeconds.Add(Seconds);
+				if (HttpSeconds.Num() < Calls)
+				{
+					SendHttp(false);
+					return;
+				}
+
+				BurstStart = FPlatformTime::Seconds();
+				BurstAnswered = 0;
+				for (int32 Call = 0; Call < Calls; ++Call)
+				{
+					SendHttp(true);
+				}
+				return;
+			}
+
+			if (++BurstAnswered == Calls)
+			{
+				HttpBurstSeconds = FPlatformTime::Seconds() - BurstStart;
+				ConnectWebSocket();
+			}
+		}
+
+		void ConnectWebSocket()
+		{
+			Socket = FWebSocketsModule::Get().CreateWebSocket(TEXT("ws://127.0.0.1:8090"));
+
+			TWeakPtr<FLatencyProbe> WeakThis = AsShared();
+			Socket->OnConnected().AddLambda([WeakThis]()
+			{
+				if (TSharedPtr<FLatencyProbe> This = WeakThis.Pin())
+				{
+					This->SendWebSocket();
+				}
+			});
+			Socket->OnConnectionError().AddLambda([WeakThis](const FString& Reason)
+			{
+				if (TSharedPtr<FLatencyProbe> This = WeakThis.Pin())
+				{
+					This->Fail(FString::Printf(TEXT("WebSocket connection failed (%s); is the bridge listening on port 8090?"), *Reason));
+				}
+			});
+			Socket->OnRawMessage().AddSP(this, &FLatencyProbe::OnRawMessage);
+			Socket->Connect();
+		}
+
+		void SendWebSocket()
+		{
+			const FString Envelope = FString::Printf(TEXT("{\"id\":\"%d\",\"op\":\"status\"}"), NextRequestId++);
+			const FTCHARToUTF8 Utf8(*Envelope, Envelope.Len());
+			SentAt.Add(NextRequestId - 1, FPlatformTime::Seconds());
+			Socket->Send(Utf8.Get(), Utf8.Length(), true);
+		}
+
+		void OnRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+		{
+			if (bFinished)
+			{
+				return;
+			}
+			Frame.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+			if (BytesRemaining > 0)
+			{
+				return;
+			}
+
+			int32 EnvelopeSize = Frame.IndexOfByKey(static_cast<uint8>('\n'));
+			if (EnvelopeSize == INDEX_NONE)
+			{
+				EnvelopeSize = Frame.Num();
+			}
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Frame.GetData()), EnvelopeSize);
+			const FString Text(Converted.Length(), Converted.Get());
+			Frame.Reset();
+
+			TSharedPtr<FJsonObject> Envelope;
+			FString Id;
+			int32 Status = 0;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Envelope) || !Envelope.IsValid()
+				|| !Envelope->TryGetStringField(TEXT("id"), Id) || !Envelope->TryGetNumberField(TEXT("status"), Status) || Status != 200)
+			{
+				Fail(FString::Printf(TEXT("Unexpected WebSocket response: %s"), *Text));
+				return;
+			}
+
+			double RequestSentAt = 0.0;
+			if (!SentAt.RemoveAndCopyValue(FCString::Atoi(*Id), RequestSentAt))
+			{
+				Fail(FString::Printf(TEXT("WebSocket response for unknown request %s"), *Id));
+				return;
+			}
+			OnWebSocketAnswered(FPlatformTime::Seconds() - RequestSentAt);
+		}
+
+		void OnWebSocketAnswered(double Seconds)
+		{
+			if (WebSocketSeconds.Num() < Calls)
+			{
+				WebSocketSeconds.Add(Seconds);
+				if (WebSocketSeconds.Num() < Calls)
+				{
+					SendWebSocket();
+					return;
+				}
+
+				// Pipelined: every request goes out on the one socket before the first answer comes back
+				BurstStart = FPlatformTime::Seconds();
+				BurstAnswered = 0;
+				for (int32 Call = 0; Call < Calls; ++Call)
+				{
+					SendWebSocket();
+				}
+				return;
+			}
+
+			if (++BurstAnswered == Calls)
+			{
+				WebSocketBurstSeconds = FPlatformTime::Seconds() - BurstStart;
+				Stop();
+			}
+		}
+
+		TSharedPtr<IWebSocket> Socket;
+		TArray<uint8> Frame;
+		TMap<int32, double> SentAt;
+		int32 NextRequestId = 1;
+		double BurstStart = 0.0;
+		int32 BurstAnswered = 0;
+		bool bFinished = false;
+	};
+
+	static FString Describe(TArray<double> Samples)
+	{
+		if (Samples.Num() == 0)
+		{
+			return TEXT("no samples");
+		}
+		Samples.Sort();
+		double Total = 0.0;
+		for (const double Sample : Samples)
+		{
+			Total += Sample;
+		}
+		return FString::Printf(TEXT("mean %.2f ms, median %.2f ms, p95 %.2f ms"), Total * 1000.0 / Samples.Num(),
+			Samples[Samples.Num() / 2] * 1000.0, Samples[FMath::Min(Samples.Num() * 95 / 100, Samples.Num() - 1)] * 1000.0);
+	}
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_THREE_PARAMETER(FWaitForBridgeLatencyProbe, TSharedRef<BridgeTransportPerfTest::FLatencyProbe>, Probe,
+	FAutomationTestBase*, Test, double, StartTime);
+
+bool FWaitForBridgeLatencyProbe::Update()
+{
+	using namespace BridgeTransportPerfTest;
+
+	if (!Probe->IsFinished())
+	{
+		if (FPlatformTime::Seconds() - StartTime < TimeoutSeconds)
+		{
+			return false;
+		}
+		Probe->Stop();
+		Test->AddError(TEXT("Timed out waiting for the bridge to answer"));
+		return true;
+	}
+
+	if (!Probe->Error.IsEmpty())
+	{
+		Test->AddError(Probe->Error);
+		return true;
+	}
+
+	Test->AddInfo(FString::Printf(TEXT("HTTP GET /api/status x%d sequential: %s"), Calls, *Describe(Probe->HttpSeconds)));
+	Test->AddInfo(FString::Printf(TEXT("WebSocket status x%d sequential: %s"), Calls, *Describe(Probe->WebSocketSeconds)));
+	Test->AddInfo(FString::Printf(TEXT("x%d in flight at once: HTTP %.2f ms, WebSocket pipelined %.2f ms"),
+		Calls, Probe->HttpBurstSeconds * 1000.0, Probe->WebSocketBurstSeconds * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBridgeTransportLatencyPerfTest, "BlueprintAIBridge.Perf.Transport.WebSocketVsHttp",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBridgeTransportLatencyPerfTest::RunTest(const FString& Parameters)
+{
+	TSharedRef<BridgeTransportPerfTest::FLatencyProbe> Probe = MakeShared<BridgeTransportPerfTest::FLatencyProbe>();
+	Probe->Start();
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForBridgeLatencyProbe(Probe, this, FPlatformTime::Seconds()));
+	return true;
+}
+
+#endif
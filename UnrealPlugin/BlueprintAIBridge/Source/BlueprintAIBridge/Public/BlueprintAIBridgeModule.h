@@ -20,4 +20,7 @@ private:
 	TArray<FHttpRouteHandle> RouteHandles;
 
 	static constexpr uint32 ListenPort = 8089;
+
+	/** Persistent-connection transport for the same operations (see FBridgeWebSocketServer) */
+	static constexpr uint32 WebSocketPort = 8090;
 };
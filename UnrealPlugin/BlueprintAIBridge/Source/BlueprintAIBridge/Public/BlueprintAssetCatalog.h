@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+class IAssetRegistry;
+
+/** Filters and page position for a project-wide blueprint listing */
+struct FBlueprintCatalogQuery
+{
+	/**
+	 * Package path prefix, e.g. "/Game/AI" (matches "/Game/AI/BP_Enemy" and "/Game/AIDirector/...").
+	 * Without one only project content (/Game) is listed; engine and plugin content need a prefix naming them.
+	 */
+	FString PathPrefix;
+	/** Parent class as a short name ("Character") or class path ("/Script/Engine.Character") */
+	FString ParentClass;
+	/** Only assets whose package file changed after this time */
+	TOptional<FDateTime> ModifiedSince;
+	/** Object path of the last asset on the previous page; empty for the first page */
+	FString Cursor;
+	int32 Limit = 200;
+};
+
+/** What the Asset Registry knows about one blueprint, read from its tags */
+struct FBlueprintCatalogEntry
+{
+	FString Name;
+	FString Path;
+	FString ParentClass;
+	FString NativeParentClass;
+	FString BlueprintType;
+	int32 NumReplicatedProperties = 0;
+	bool bIsDataOnly = false;
+	bool bIsLoaded = false;
+	FDateTime Modified;
+};
+
+struct FBlueprintCatalogPage
+{
+	TArray<FBlueprintCatalogEntry> Entries;
+	/** Pass back as the cursor for the next page; empty on the last one */
+	FString NextCursor;
+	/** Assets matching the filters across all pages */
+	int32 Total = 0;
+	/** False while the registry is still discovering assets, so later pages may grow */
+	bool bComplete = true;
+};
+
+/**
+ * Lists every blueprint asset in the project straight from Asset Registry tags, without loading packages.
+ * Pages are ordered by object path and the cursor is a path, so inserting or deleting assets between
+ * requests never skips or repeats the ones that are left.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintAssetCatalog
+{
+public:
+	static FBlueprintCatalogPage Query(const FBlueprintCatalogQuery& Query);
+
+	/** Largest page a client may ask for */
+	static constexpr int32 MaxLimit = 1000;
+
+private:
+	static bool MatchesParentClass(const FAssetData& AssetData, const FString& ParentClass);
+	static FString GetClassTag(const FAssetData& AssetData, FName Tag);
+	/** Package file time, stat'ed once per saved version of the package the registry knows about */
+	static FDateTime GetModifiedTime(const IAssetRegistry& AssetRegistry, const FAssetData& AssetData);
+	static void FillEntry(const IAssetRegistry& AssetRegistry, const FAssetData& AssetData, FBlueprintCatalogEntry& OutEntry);
+};
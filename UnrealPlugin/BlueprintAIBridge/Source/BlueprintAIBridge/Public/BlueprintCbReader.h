@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/CompactBinary.h"
+#include "BlueprintData.h"
+
+/**
+ * Reads Compact Binary (application/x-ue-cb) request bodies into the same FBlueprint*Data records
+ * FBlueprintJsonReader produces. Field names match the JSON encoding; IDs may be Uuid or string fields.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintCbReader
+{
+public:
+	/** The body view must outlive the reader */
+	explicit FBlueprintCbReader(TConstArrayView<uint8> Body);
+
+	/** Validate and parse a BlueprintDelta. A body without "type" is read as a raw state and reported as a FullSync. */
+	bool ReadDelta(FBlueprintDeltaData& OutDelta);
+
+	const FString& GetError() const { return Error; }
+
+private:
+	static void ReadState(FCbObjectView Object, FBlueprintStateData& OutState);
+	static void ReadNode(FCbObjectView Object, FBlueprintNodeData& OutNode);
+	static void ReadPins(FCbArrayView Array, TArray<FBlueprintPinData>& OutPins);
+	static void ReadConnection(FCbObjectView Object, FBlueprintConnectionData& OutConnection);
+	static void ReadVariable(FCbObjectView Object, FBlueprintVariableData& OutVariable);
+
+	static FString ReadString(FCbFieldView Field);
+	/** A string, or a number or bool turned into its string form, as FBlueprintJsonReader reads them */
+	static FString ReadDefaultValue(FCbFieldView Field);
+	static FString ReadId(FCbFieldView Field);
+
+	bool Fail(const FString& Message);
+
+	TConstArrayView<uint8> Body;
+	FString Error;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/CompactBinary.h"
+#include "Serialization/CompactBinaryWriter.h"
+
+/**
+ * Thin adapter exposing the subset of the TJsonWriter API the serializer uses on top of FCbWriter,
+ * so the same export walk can emit either JSON or Compact Binary.
+ * IDs that parse as GUIDs are stored as 16-byte Uuid fields instead of 36-char strings.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintCbWriter
+{
+public:
+	void WriteObjectStart();
+	void WriteObjectEnd();
+	void WriteArrayStart(const TCHAR* Key);
+	void WriteArrayEnd();
+
+	void WriteValue(const TCHAR* Key, const FString& Value);
+	void WriteValue(const TCHAR* Key, const TCHAR* Value);
+	void WriteValue(const TCHAR* Key, int32 Value);
+	void WriteValue(const TCHAR* Key, bool Value);
+
+	/** Write a node/pin/connection/variable ID, as a Uuid when it is one */
+	void WriteId(const TCHAR* Key, const FString& Id);
+
+	/** Splice a previously encoded object into the current array */
+	void WriteObject(const FCbObject& Object);
+
+	/** Splice a previously encoded object into the current object under Key */
+	void WriteObject(const TCHAR* Key, const FCbObjectView& Object);
+
+	/** Copy the finished object out as a single self-describing Compact Binary field */
+	TArray<uint8> Save() const;
+
+	/** Keep the finished object as an FCbObject, for splicing into a later document */
+	FCbObject SaveObject() const;
+
+private:
+	void SetName(const TCHAR* Key);
+
+	FCbWriter Writer;
+};
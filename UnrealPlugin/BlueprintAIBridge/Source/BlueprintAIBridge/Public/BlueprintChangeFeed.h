@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpResultCallback.h"
+#include "UObject/WeakObjectPtr.h"
+#include "BlueprintData.h"
+
+class UBlueprint;
+class UEdGraphNode;
+class FBlueprintSerializer;
+class FBlueprintRevisionTracker;
+
+/** Blueprint, event id, event name ("delta" or "compiled"), event data as JSON */
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnBlueprintChangeEvent, UBlueprint*, uint64, const TCHAR*, const FString&);
+
+/**
+ * Turns editor-side edits into BlueprintDelta records for GET /api/blueprint/events.
+ *
+ * When a watched blueprint's revision moves, the feed waits a short coalescing window, re-reads the nodes
+ * the revision tracker reported as changed (plus their neighbors, whose links may have moved), diffs them
+ * against its snapshot and queues NodeAdded/NodeRemoved/NodeUpdated, ConnectionAdded/ConnectionRemoved and
+ * VariableAdded/VariableRemoved records, plus a "compiled" event after each compile. Blueprint-wide edits
+ * fall back to re-exporting and diffing the whole blueprint.
+ *
+ * The engine's HTTP server cannot stream a response, so each request is held until events arrive and
+ * is then answered as a complete text/event-stream body. EventSource clients reconnect straight away
+ * with Last-Event-ID and see a continuous stream.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintChangeFeed
+{
+public:
+	/** How long edits are coalesced before a diff is taken (a node drag becomes one NodeUpdated per window) */
+	static constexpr double CoalesceSeconds = 0.05;
+
+	/** How long an events request is held open when nothing happens */
+	static constexpr double PollTimeoutSeconds = 20.0;
+
+	explicit FBlueprintChangeFeed(FBlueprintRevisionTracker& InRevisions);
+	~FBlueprintChangeFeed();
+
+	/**
+	 * Answer with every event after LastEventId, holding the request until there is one.
+	 * Without a LastEventId the client only sees edits made from now on.
+	 */
+	void Subscribe(UBlueprint* Blueprint, TOptional<uint64> LastEventId, const FHttpResultCallback& OnComplete);
+
+	/** Keep diffing a blueprint while a push listener cares about it, whether or not any request is held */
+	void Watch(UBlueprint* Blueprint);
+	void Unwatch(UBlueprint* Blueprint);
+
+	/** Fired on the game thread for every queued event, for transports that can push */
+	FOnBlueprintChangeEvent& OnChangeEvent() { return ChangeEvent; }
+
+private:
+	struct FEvent
+	{
+		uint64 Id = 0;
+		const TCHAR* Name = nullptr;
+		FString Data;
+	};
+
+	struct FWaiter
+	{
+		uint64 LastEventId = 0;
+		double Deadline = 0.0;
+		FHttpResultCallback OnComplete;
+	};
+
+	struct FChannel
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		TSharedPtr<FBlueprintSerializer> Serializer;
+
+		/** The state as of the last diff, keyed by ID so a diff of a few nodes can update it in place */
+		FString Name;
+		TMap<FString, FBlueprintNodeData> Nodes;
+		TMap<FString, FBlueprintConnectionData> Connections;
+		TArray<FBlueprintVariableData> Variables;
+		/** Node ID -> IDs of the connections touching it */
+		TMultiMap<FString, FString> NodeConnections;
+
+		/** Nodes changed since the last diff */
+		TSet<FGuid> DirtyNodes;
+		/** A blueprint-wide edit happened, so the next diff re-exports everything */
+		bool bFullDiffPending = false;
+
+		TArray<FEvent> Backlog;
+		/** Newest event ID trimmed from Backlog; IDs are shared by all channels, so the backlog itself has gaps */
+		uint64 TrimmedThroughId = 0;
+		TArray<FWaiter> Waiters;
+		FDelegateHandle CompiledHandle;
+		double PendingSince = 0.0;
+		double LastSubscribed = 0.0;
+		int32 Watchers = 0;
+		bool bDiffPending = false;
+		bool bCompiledPending = false;
+	};
+
+	FChannel* FindOrCreateChannel(UBlueprint* Blueprint);
+	void DestroyChannel(FChannel& Channel);
+
+	bool Tick(float DeltaTime);
+	void OnRevisionChanged(UBlueprint* Blueprint);
+	void OnNodeChanged(UBlueprint* Blueprint, const UEdGraphNode* Node);
+	void OnStructureChanged(UBlueprint* Blueprint);
+	void OnBlueprintCompiled(UBlueprint* Blueprint);
+	void ScheduleDiff(FChannel& Channel);
+
+	bool CaptureState(FChannel& Channel, FBlueprintStateData& OutState);
+	/** Export DirtyNodes, the nodes they were linked to and the nodes they are linked to now; OutScope gets every node ID the capture speaks for */
+	bool CaptureNodes(FChannel& Channel, const TSet<FGuid>& DirtyNodes, FBlueprintStateData& OutState, TSet<FString>& OutScope);
+	void DiffAndQueue(FChannel& Channel);
+	static void AddConnection(FChannel& Channel, const FBlueprintConnectionData& Connection);
+	static void RemoveConnection(FChannel& Channel, const FString& ConnectionId);
+	static FBlueprintStateData MakeState(const FChannel& Channel);
+	void QueueDelta(FChannel& Channel, FBlueprintDeltaData&& Delta);
+	void QueueEvent(FChannel& Channel, const TCHAR* Name, FString&& Data);
+
+	/** Complete waiters that have something to read (or have timed out) */
+	void Flush(FChannel& Channel, double Now, bool bForce);
+
+	FBlueprintRevisionTracker& Revisions;
+	TMap<TWeakObjectPtr<UBlueprint>, TUniquePtr<FChannel>> Channels;
+	FDelegateHandle RevisionChangedHandle;
+	FDelegateHandle NodeChangedHandle;
+	FDelegateHandle StructureChangedHandle;
+	FTSTicker::FDelegateHandle TickHandle;
+	FOnBlueprintChangeEvent ChangeEvent;
+	uint64 NextEventId = 1;
+};
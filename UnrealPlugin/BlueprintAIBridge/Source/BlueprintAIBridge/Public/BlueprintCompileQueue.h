@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+
+/** One error or warning a compile left on a node */
+struct FBlueprintCompileMessage
+{
+	/** Bridge node ID, as exported */
+	FString NodeId;
+	FString NodeTitle;
+	FString Message;
+};
+
+/** Outcome of compiling one blueprint */
+struct FBlueprintCompileResult
+{
+	FString Name;
+	FString Path;
+	/** "upToDate", "upToDateWithWarnings", "error" or "dirty" */
+	FString Status;
+	TArray<FBlueprintCompileMessage> Errors;
+	TArray<FBlueprintCompileMessage> Warnings;
+
+	bool HasErrors() const { return Status == TEXT("error") || Errors.Num() > 0; }
+};
+
+/**
+ * Defers blueprint compilation until editing has settled. Edits mark a blueprint dirty; it is compiled once
+ * nothing has touched it for QuietSeconds, or straight away when a caller wants the results. Everything due
+ * at the same time goes to the engine's compilation manager as one batch, which orders the blueprints by
+ * dependency and compiles each (and the blueprints depending on it) once.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintCompileQueue
+{
+public:
+	/** How long a blueprint must go unedited before it compiles on its own */
+	static constexpr double QuietSeconds = 0.5;
+
+	FBlueprintCompileQueue();
+	~FBlueprintCompileQueue();
+
+	/** Note an edit; restarts the blueprint's quiet period */
+	void MarkDirty(UBlueprint* Blueprint);
+
+	/** True while the blueprint has edits that have not been compiled */
+	bool IsPending(const UBlueprint* Blueprint) const;
+
+	/** Keep the blueprint out of queued compiles while an edit spread over several frames is half applied */
+	void Hold(const UBlueprint* Blueprint);
+	void Release(const UBlueprint* Blueprint);
+
+	/**
+	 * Compile Blueprints now, together with every other blueprint waiting for its quiet period, in a single
+	 * pass. Returns one result per entry of Blueprints, in the same order.
+	 */
+	TArray<FBlueprintCompileResult> CompileNow(const TArray<UBlueprint*>& Blueprints);
+
+	/** Status and per-node messages left by the blueprint's last compile */
+	static FBlueprintCompileResult CollectResult(UBlueprint* Blueprint);
+
+private:
+	bool Tick(float DeltaTime);
+	void CompileBatch(const TArray<UBlueprint*>& Batch);
+
+	/** Dirty blueprints and the time of their last edit */
+	TMap<TWeakObjectPtr<UBlueprint>, double> Pending;
+	/** Held blueprints stay pending however long they have been quiet */
+	TSet<TWeakObjectPtr<UBlueprint>> Held;
+	FTSTicker::FDelegateHandle TickHandle;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Plain records mirroring the BlueprintAI domain model (BlueprintNode, Pin, Connection, ...).
+ * Request bodies are parsed straight into these, and the deserializer builds graphs from them.
+ */
+
+struct FBlueprintPinData
+{
+	FString Id;
+	FString Name;
+	FString Type;
+	FString DefaultValue;
+	FString SubType;
+	bool bHasDefaultValue = false;
+	bool bIsConnected = false;
+};
+
+struct FBlueprintNodeData
+{
+	FString Id;
+	FString Title;
+	FString Category;
+	FString Style;
+	int32 PosX = 0;
+	int32 PosY = 0;
+	bool bIsCompact = false;
+	TArray<FBlueprintPinData> InputPins;
+	TArray<FBlueprintPinData> OutputPins;
+};
+
+struct FBlueprintConnectionData
+{
+	FString Id;
+	FString SourceNodeId;
+	FString SourcePinId;
+	FString TargetNodeId;
+	FString TargetPinId;
+	FString PinType;
+};
+
+struct FBlueprintVariableData
+{
+	FString Id;
+	FString Name;
+	FString Type;
+	FString DefaultValue;
+	FString Category;
+	bool bIsEditable = false;
+};
+
+struct FBlueprintStateData
+{
+	FString Name;
+	TArray<FBlueprintNodeData> Nodes;
+	TArray<FBlueprintConnectionData> Connections;
+	TArray<FBlueprintVariableData> Variables;
+
+	/** False when the payload omitted the array, so callers can leave that part of the blueprint alone */
+	bool bHasVariables = false;
+};
+
+/** A BlueprintDelta payload; only the member matching Type is meaningful */
+struct FBlueprintDeltaData
+{
+	FString Type;
+	TOptional<FBlueprintNodeData> Node;
+	TOptional<FBlueprintConnectionData> Connection;
+	TOptional<FBlueprintVariableData> Variable;
+	FString RemovedId;
+	TOptional<FBlueprintStateData> FullState;
+	int32 Version = 0;
+};
+
+/** Body of POST /api/blueprint/create */
+struct FBlueprintCreateRequest
+{
+	FString Name;
+	FString Path = TEXT("/Game/Blueprints");
+	FString ParentClass = TEXT("Actor");
+	TOptional<FBlueprintStateData> State;
+};
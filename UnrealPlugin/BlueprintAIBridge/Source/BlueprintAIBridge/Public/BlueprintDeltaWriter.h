@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "BlueprintData.h"
+
+/**
+ * Writes FBlueprintDeltaData records as condensed single-line JSON in the backend's BlueprintDelta shape
+ * ({ "type", "node", "connection", "comment", "variable", "removedId", "fullState", "version" }).
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintDeltaWriter
+{
+public:
+	static FString Write(const FBlueprintDeltaData& Delta);
+
+private:
+	using FWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	static void WriteState(FWriter& Writer, const FBlueprintStateData& State);
+	static void WriteNode(FWriter& Writer, const FBlueprintNodeData& Node);
+	static void WritePins(FWriter& Writer, const TCHAR* Key, const TArray<FBlueprintPinData>& Pins, const TCHAR* Direction);
+	static void WriteConnection(FWriter& Writer, const FBlueprintConnectionData& Connection);
+	static void WriteVariable(FWriter& Writer, const FBlueprintVariableData& Variable);
+};
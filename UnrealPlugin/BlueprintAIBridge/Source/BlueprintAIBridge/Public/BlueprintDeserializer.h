@@ -1,41 +1,174 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include "EdGraph/EdGraphPin.h"
+#include "UObject/WeakObjectPtr.h"
+#include "BlueprintData.h"
 
 class UBlueprint;
 class UEdGraph;
+class FBlueprintCompileQueue;
+
+/** Where a time-sliced full sync has got to */
+struct FBlueprintApplyProgress
+{
+	/** "preparing", "removing", "nodes", "links" or "compiling" */
+	const TCHAR* Phase = TEXT("");
+	int32 NodesProcessed = 0;
+	int32 NodesTotal = 0;
+	int32 NodesCreated = 0;
+	int32 LinksWired = 0;
+	int32 LinksTotal = 0;
+	double ElapsedSeconds = 0.0;
+};
 
 /**
- * Applies a full-sync JSON blueprint state to a UE Blueprint graph.
- * Clears the existing graph and rebuilds nodes + connections from the JSON payload.
+ * Applies blueprint state (parsed by FBlueprintJsonReader) to a UE Blueprint graph.
+ * Full syncs reconcile the payload against the graphs an export covers and apply only the difference;
+ * typed deltas (NodeAdded, ConnectionRemoved, ...) are applied surgically against the live graph.
+ *
+ * A full sync runs as a sequence of small steps, so a large one can also be spread across frames.
+ * Nothing is compiled here: modified blueprints are handed to the compile queue, which compiles them once
+ * the edits stop coming.
  */
 class BLUEPRINTAIBRIDGE_API FBlueprintDeserializer
 {
 public:
-	bool ApplyFullSync(UBlueprint* Blueprint, const TSharedPtr<FJsonObject>& JsonState);
+	using FOnApplyFinished = TFunction<void(bool bSuccess)>;
+
+	/** Game-thread time a sliced full sync may take per frame, shared between all running ones */
+	static constexpr double SliceBudgetSeconds = 0.004;
+
+	explicit FBlueprintDeserializer(FBlueprintCompileQueue& InCompiles);
+	~FBlueprintDeserializer();
+
+	bool ApplyFullSync(UBlueprint* Blueprint, const FBlueprintStateData& State);
+
+	/**
+	 * Apply a full sync a few milliseconds per frame from the core ticker, queuing one compile at the end.
+	 * OnFinished runs on the game thread when it is done. Returns false (without calling OnFinished) if the
+	 * blueprint has no event graph or is already being applied.
+	 */
+	bool ApplyFullSyncSliced(UBlueprint* Blueprint, FBlueprintStateData&& State, FOnApplyFinished&& OnFinished);
+
+	/**
+	 * Stop a sliced full sync before it finishes; OnFinished is not called. What was applied so far stays
+	 * in the graph, marked modified and queued for compilation. Returns false if there is none or it has
+	 * reached its final step.
+	 */
+	bool CancelSlicedSync(const UBlueprint* Blueprint);
+
+	/** True while a sliced full sync is working on this blueprint */
+	bool IsApplying(const UBlueprint* Blueprint) const;
+
+	/** Progress of the sliced full sync on this blueprint; false if there is none */
+	bool GetApplyProgress(const UBlueprint* Blueprint, FBlueprintApplyProgress& OutProgress) const;
+
+	/**
+	 * Apply a BlueprintDelta payload ({ "type": "NodeAdded", "node": { ... }, ... }).
+	 * FullSync deltas are forwarded to ApplyFullSync; the reader turns a body without a "type" field into one.
+	 */
+	bool ApplyDelta(UBlueprint* Blueprint, const FBlueprintDeltaData& Delta);
 
 private:
-	UEdGraphNode* CreateNodeFromJson(UBlueprint* Blueprint, UEdGraph* Graph, const TSharedPtr<FJsonObject>& NodeJson);
+	struct FFullSyncTask;
+
+	/** Live nodes of one blueprint by GUID; built once per apply, so ID lookups and collision checks don't rescan every graph */
+	using FNodeIndex = TMap<FGuid, TWeakObjectPtr<UEdGraphNode>>;
+
+	TSharedPtr<FFullSyncTask> BeginFullSync(UBlueprint* Blueprint, FBlueprintStateData&& State);
+	/** Advance a full sync until BudgetSeconds run out; true once it has finished */
+	bool StepFullSync(FFullSyncTask& Task, double BudgetSeconds);
+	void FinishFullSync(FFullSyncTask& Task, UBlueprint* Blueprint);
+	bool TickSlicedSyncs(float DeltaTime);
+
+	bool ApplyNodeAdded(UBlueprint* Blueprint, FNodeIndex& Nodes, const FBlueprintNodeData& NodeData, bool& bOutModified);
+	bool ApplyNodeRemoved(UBlueprint* Blueprint, FNodeIndex& Nodes, const FString& NodeId, bool& bOutModified);
+	bool ApplyNodeUpdated(UBlueprint* Blueprint, FNodeIndex& Nodes, const FBlueprintNodeData& NodeData, bool& bOutModified);
+	bool ApplyConnectionAdded(UBlueprint* Blueprint, const FNodeIndex& Nodes, const FBlueprintConnectionData& Connection, bool& bOutModified);
+	bool ApplyConnectionRemoved(UBlueprint* Blueprint, const FString& ConnectionId, bool& bOutModified);
+	bool ApplyVariableAdded(UBlueprint* Blueprint, const FBlueprintVariableData& Variable, bool& bOutModified);
+	bool ApplyVariableRemoved(UBlueprint* Blueprint, const FString& VariableId, bool& bOutModified);
+
+	UEdGraph* GetEventGraph(UBlueprint* Blueprint) const;
+	/** Every node in every graph of Blueprint, keyed by the GUID its exported ID is made from */
+	static void IndexNodes(UBlueprint* Blueprint, FNodeIndex& OutNodes);
+	static UEdGraphNode* FindNodeById(const FNodeIndex& Nodes, const FString& NodeId);
+	UEdGraphPin* ResolvePin(UEdGraphNode* Node, const FString& NodeId, const FString& PinId,
+		const FString& PinType, EEdGraphPinDirection Direction);
+
+	/** Give a freshly created node the node/pin IDs the backend assigned, so later deltas and exports agree on them */
+	void AdoptIncomingIds(FNodeIndex& Nodes, UEdGraphNode* Node, const FBlueprintNodeData& NodeData);
+	bool ApplyPinDefaults(UEdGraphNode* Node, const FBlueprintNodeData& NodeData);
+	void RecordPinNames(const FBlueprintNodeData& NodeData);
+
+	/** Match incoming nodes to live nodes of Graphs by ID, then to event graph nodes by (style, title, position) */
+	void MatchExistingNodes(const TArray<UEdGraph*>& Graphs, UEdGraph* EventGraph, const TArray<FBlueprintNodeData>& IncomingNodes,
+		TMap<FString, UEdGraphNode*>& OutMatched) const;
+
+	/** Create a node and index it under the ID it ends up with */
+	UEdGraphNode* CreateNodeFromData(UBlueprint* Blueprint, UEdGraph* Graph, FNodeIndex& Nodes, const FBlueprintNodeData& NodeData);
 	UEdGraphNode* CreateEventNode(UBlueprint* Blueprint, UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY);
 	UEdGraphNode* CreateFunctionNode(UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY);
 	UEdGraphNode* CreateFlowControlNode(UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY);
 	UEdGraphNode* CreatePureNode(UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY);
 
-	bool WireConnections(UEdGraph* Graph, const TArray<TSharedPtr<FJsonValue>>& Connections,
-		const TMap<FString, UEdGraphNode*>& NodeMap,
-		const TMap<FString, TMap<FString, FString>>& PinIdToNameMap);
+	bool WireConnection(const FBlueprintConnectionData& Connection, UEdGraphNode* SourceNode, UEdGraphNode* TargetNode);
+	/** Remember which pins a backend connection ID links, so a later ConnectionRemoved can find them */
+	void RecordConnection(const FString& ConnectionId, UEdGraphPin* SourcePin, UEdGraphPin* TargetPin);
+	/** Index every live link of Blueprint under the connection ID exports give it, dropping entries whose pins are gone */
+	void IndexLiveConnections(UBlueprint* Blueprint);
+	bool ResolveConnectionPins(const FBlueprintConnectionData& Connection, UEdGraphNode* SourceNode, UEdGraphNode* TargetNode,
+		UEdGraphPin*& OutSourcePin, UEdGraphPin*& OutTargetPin);
 
-	void CreateVariablesFromJson(UBlueprint* Blueprint, const TArray<TSharedPtr<FJsonValue>>& VariablesArray);
-	UEdGraphNode* CreateVariableNode(UBlueprint* Blueprint, UEdGraph* Graph, const FString& Title, const TSharedPtr<FJsonObject>& NodeJson, int32 PosX, int32 PosY);
+	/** What SyncVariables changed */
+	struct FVariableSyncResult
+	{
+		int32 Added = 0;
+		int32 Removed = 0;
+		int32 Renamed = 0;
+		int32 Retyped = 0;
+		/** Default value, category or flags changed; the class layout did not */
+		int32 Updated = 0;
+
+		bool IsStructural() const { return Added + Removed + Renamed + Retyped > 0; }
+	};
+
+	/**
+	 * Bring the member variables in line with Variables, matching them by variable ID, then by name. Only
+	 * what differs is added, removed, renamed, retyped or updated, so matched variables keep their VarGuid
+	 * and the nodes referencing them, and an unchanged list leaves the blueprint untouched. Additions are not
+	 * marked structural here; the caller does that once per apply, when IsStructural() says so.
+	 */
+	FVariableSyncResult SyncVariables(UBlueprint* Blueprint, const TArray<FBlueprintVariableData>& Variables);
+	/**
+	 * Append a member variable description without touching the skeleton class; the caller marks the blueprint
+	 * structurally modified once it has added them all. TakenNames holds the names already in use and gains the new one.
+	 */
+	bool AddVariableFromData(UBlueprint* Blueprint, const FBlueprintVariableData& Variable, TSet<FName>& TakenNames);
+	/** PropertyFlags with isEditable applied: instance editable, as the details panel sets it, or editable on defaults only */
+	static uint64 ApplyEditableFlags(uint64 PropertyFlags, bool bIsEditable);
+	UEdGraphNode* CreateVariableNode(UBlueprint* Blueprint, UEdGraph* Graph, const FString& Title, int32 PosX, int32 PosY);
+	/** Make sure the skeleton class has VarName, regenerating just the skeleton at most once per apply if it doesn't */
+	void EnsureSkeletonVariable(UBlueprint* Blueprint, FName VarName);
 	FEdGraphPinType MapPinTypeFromString(const FString& TypeStr);
 
 	UEdGraphPin* FindPinByName(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction);
-	UFunction* FindFunctionByDisplayName(const FString& DisplayName);
+	UFunction* FindFunctionByDisplayName(const FString& DisplayName, const UClass* ContextClass = nullptr);
+
+	FBlueprintCompileQueue& Compiles;
 
-	/** Maps JSON pin ID → pin display name, per node ID */
+	/** Maps incoming pin ID → pin display name, per node ID */
 	TMap<FString, TMap<FString, FString>> PinNameMap;
 
-	/** Cache for FindFunctionByDisplayName to avoid repeated TObjectIterator scans */
-	TMap<FString, UFunction*> FunctionCache;
+	/** Connection ID (backend-minted or exported) -> the (source, target) pins it links */
+	TMap<FGuid, TPair<FEdGraphPinReference, FEdGraphPinReference>> ConnectionPins;
+
+	/** Blueprints whose skeleton was regenerated by the apply in progress on them; cleared when the next one starts */
+	TSet<TWeakObjectPtr<UBlueprint>> RefreshedSkeletons;
+
+	/** Full syncs being applied a slice per frame */
+	TMap<TWeakObjectPtr<UBlueprint>, TSharedRef<FFullSyncTask>> SlicedSyncs;
+	FTSTicker::FDelegateHandle SliceTickHandle;
 };
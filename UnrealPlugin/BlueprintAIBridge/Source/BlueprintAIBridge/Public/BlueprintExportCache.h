@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintSerializer.h"
+
+/**
+ * Bounded cache of encoded blueprint exports, keyed by blueprint path and wire format and
+ * tagged with the revision they were produced at. A lookup at any other revision is a miss.
+ * The least recently used entries are evicted once the byte budget is exceeded.
+ * Bodies are shared, immutable buffers: a hit hands out the cached buffer rather than a copy of it.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintExportCache
+{
+public:
+	struct FStats
+	{
+		int64 Hits = 0;
+		int64 Misses = 0;
+		int64 Evictions = 0;
+		int64 Bytes = 0;
+		int32 Entries = 0;
+	};
+
+	/** An encoded body; thread-safe, since responses are compressed and batches assembled off the game thread */
+	using FBody = TSharedRef<const TArray<uint8>, ESPMode::ThreadSafe>;
+
+	explicit FBlueprintExportCache(int64 InMaxBytes = 64 * 1024 * 1024);
+
+	/** Point OutBody at the cached body for this revision; false on a miss */
+	bool Find(const FString& Path, EBlueprintWireFormat Format, uint64 Revision, TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>& OutBody);
+
+	/** Store an encoded body, evicting older entries to stay within budget */
+	void Add(const FString& Path, EBlueprintWireFormat Format, uint64 Revision, const FBody& Body);
+
+	/** Drop every format cached for a blueprint */
+	void Invalidate(const FString& Path);
+
+	FStats GetStats() const;
+	int64 GetMaxBytes() const { return MaxBytes; }
+
+private:
+	struct FEntry
+	{
+		uint64 Revision = 0;
+		uint64 LastUsed = 0;
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Body;
+	};
+
+	using FKey = TPair<FString, EBlueprintWireFormat>;
+
+	void Remove(const FKey& Key);
+
+	TMap<FKey, FEntry> Entries;
+	int64 MaxBytes;
+	int64 TotalBytes = 0;
+	uint64 UseCounter = 0;
+
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 Evictions = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UClass;
+class UFunction;
+
+/**
+ * Index of every reflected UFunction by display name and internal name.
+ * Built a slice per frame from the core ticker after module startup and kept current on module load,
+ * hot reload, Live Coding and blueprint load and compile, so node creation never walks TObjectIterator<UClass>. Display names come
+ * from package metadata, which is only safe to read on the game thread, so the build stays there.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintFunctionIndex
+{
+public:
+	static FBlueprintFunctionIndex& Get();
+
+	/** Game-thread time the build may take per frame */
+	static constexpr double SliceBudgetSeconds = 0.002;
+
+	/** Start the initial sliced build and subscribe to module/reload notifications */
+	void Startup();
+	void Shutdown();
+
+	/**
+	 * Resolve a function by display name (e.g. "Print String"), falling back to its internal name.
+	 * When several classes define a match, functions on ContextClass or its supers win, then Blueprint-exposed ones.
+	 * Misses are not cached, and look through the loaded blueprint classes before giving up, so functions
+	 * from modules or blueprints loaded later are still found.
+	 */
+	UFunction* Find(const FString& Name, const UClass* ContextClass = nullptr);
+
+private:
+	using FFunctionList = TArray<TWeakObjectPtr<UFunction>>;
+
+	/** Empty the index and queue every class currently loaded for indexing */
+	void StartRebuild();
+	/** Index queued classes until BudgetSeconds run out; true once the queue is empty */
+	bool StepBuild(double BudgetSeconds);
+	bool TickBuild(float DeltaTime);
+
+	void IndexClass(UClass* Class);
+	void IndexModule(FName ModuleName);
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void OnReloadComplete(EReloadCompleteReason Reason);
+	void OnAssetLoaded(UObject* Asset);
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnBlueprintCompiled();
+
+	/** Index every loaded blueprint-generated class */
+	void IndexBlueprintClasses();
+	UFunction* FindIndexed(const FString& Name, const UClass* ContextClass) const;
+
+	static UFunction* PickBest(const FFunctionList& Candidates, const UClass* ContextClass);
+
+	TMap<FString, FFunctionList> ByDisplayName;
+	TMap<FString, FFunctionList> ByInternalName;
+
+	/** Classes the build has yet to index, and where it has got to */
+	TArray<TWeakObjectPtr<UClass>> PendingClasses;
+	int32 BuildCursor = 0;
+	double BuildStartTime = 0.0;
+	FTSTicker::FDelegateHandle BuildTickHandle;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle AssetLoadedHandle;
+	FDelegateHandle PreCompileHandle;
+	FDelegateHandle CompiledHandle;
+
+	/** Blueprints in the compile that is under way; their functions are reindexed once it finishes */
+	TArray<TWeakObjectPtr<UBlueprint>> CompilingBlueprints;
+};
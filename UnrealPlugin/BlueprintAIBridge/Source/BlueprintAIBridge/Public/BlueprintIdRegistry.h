@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraphNode;
+class UEdGraphPin;
+struct FBPVariableDescription;
+
+/**
+ * Bidirectional ID registry for serialized graph elements.
+ * Resolves string ID -> node/pin and node/pin -> string ID in O(1) so the
+ * connection pass never has to scan the maps.
+ *
+ * IDs are derived from the GUIDs UE already stores on nodes, pins and variables,
+ * so an unchanged blueprint always exports the same IDs.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintIdRegistry
+{
+public:
+	/** Stable GUIDs for graph elements. Falls back to a path-derived GUID when the stored one is invalid. */
+	static FGuid GetNodeGuid(const UEdGraphNode* Node);
+	static FGuid GetPinGuid(const UEdGraphPin* Pin);
+
+	/** Connection GUID hashed from its two endpoint pin GUIDs (order-sensitive) */
+	static FGuid MakeConnectionGuid(const FGuid& SourcePinGuid, const FGuid& TargetPinGuid);
+
+	/** String forms of the above, as written to the wire */
+	static FString MakeNodeId(const UEdGraphNode* Node);
+	static FString MakePinId(const UEdGraphPin* Pin);
+	static FString MakeConnectionId(const UEdGraphPin* SourcePin, const UEdGraphPin* TargetPin);
+	static FString MakeVariableId(const FBPVariableDescription& VarDesc);
+
+	/** Clear all entries, optionally reserving room for the next export */
+	void Reset(int32 ExpectedNodes = 0, int32 ExpectedPins = 0);
+
+	void RegisterNode(const FString& Id, UEdGraphNode* Node);
+	void RegisterPin(const FString& Id, UEdGraphPin* Pin);
+
+	/** ID lookups by pointer; nullptr if the element was not registered */
+	const FString* FindNodeId(const UEdGraphNode* Node) const { return IdsByNode.Find(Node); }
+	const FString* FindPinId(const UEdGraphPin* Pin) const { return IdsByPin.Find(Pin); }
+
+	/** Pointer lookups by ID; nullptr if the ID is unknown */
+	UEdGraphNode* FindNode(const FString& Id) const;
+	UEdGraphPin* FindPin(const FString& Id) const;
+
+	const TMap<FString, UEdGraphNode*>& GetNodeMap() const { return NodesById; }
+	const TMap<FString, UEdGraphPin*>& GetPinMap() const { return PinsById; }
+
+private:
+	TMap<FString, UEdGraphNode*> NodesById;
+	TMap<FString, UEdGraphPin*> PinsById;
+	TMap<const UEdGraphNode*, FString> IdsByNode;
+	TMap<const UEdGraphPin*, FString> IdsByPin;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonReader.h"
+#include "BlueprintData.h"
+
+/**
+ * Pull-parses BlueprintAI request bodies token by token straight from the UTF-8 request bytes.
+ * No UTF-16 copy of the body and no FJsonObject tree are built; fields land directly in the
+ * FBlueprint*Data records the deserializer consumes.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintJsonReader
+{
+public:
+	/** The body view must outlive the reader */
+	explicit FBlueprintJsonReader(TConstArrayView<uint8> Utf8Body);
+
+	/** Parse a BlueprintDelta. A body without "type" is read as a raw state and reported as a FullSync. */
+	bool ReadDelta(FBlueprintDeltaData& OutDelta);
+
+	/** Parse a bare blueprint state, such as our own export */
+	bool ReadBlueprintState(FBlueprintStateData& OutState);
+
+	/** Parse a { "name", "path", "parentClass", "state" } create request */
+	bool ReadCreateRequest(FBlueprintCreateRequest& OutRequest);
+
+	/** Parse a { "names": [...] } batch request; entries may be blueprint names or object paths */
+	bool ReadNameList(TArray<FString>& OutNames);
+
+	const FString& GetError() const { return Error; }
+
+private:
+	/** Iterate the fields of an object whose ObjectStart was already consumed */
+	template <typename FieldFuncType>
+	bool ReadObject(FieldFuncType&& OnField);
+
+	/** Iterate the elements of an array whose ArrayStart was already consumed */
+	template <typename ElementFuncType>
+	bool ReadArray(ElementFuncType&& OnElement);
+
+	bool ReadState(FBlueprintStateData& OutState);
+	bool ReadStateField(const FString& Key, EJsonNotation Notation, FBlueprintStateData& OutState);
+	bool ReadNode(FBlueprintNodeData& OutNode);
+	bool ReadPins(TArray<FBlueprintPinData>& OutPins);
+	bool ReadConnection(FBlueprintConnectionData& OutConnection);
+	bool ReadVariable(FBlueprintVariableData& OutVariable);
+
+	bool ReadString(EJsonNotation Notation, FString& OutValue);
+	/** A string, or a number or bool turned into its string form */
+	bool ReadDefaultValue(EJsonNotation Notation, FString& OutValue);
+	bool ReadNumber(EJsonNotation Notation, double& OutValue);
+	bool ReadBool(EJsonNotation Notation, bool& OutValue);
+	bool Skip(EJsonNotation Notation);
+	bool Fail(const FString& Message);
+
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader;
+	FString Error;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class IAssetEditorInstance;
+struct FAssetData;
+
+/**
+ * Resolves blueprint names and paths without scanning editor tabs.
+ *
+ * Loaded blueprints are indexed under their name, object path and package path, kept current from asset
+ * editor open/close events. Every blueprint asset in the project is indexed by name from the Asset Registry,
+ * so blueprints nobody has opened can be streamed in on demand without blocking the game thread.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintLookupIndex
+{
+public:
+	FBlueprintLookupIndex();
+	~FBlueprintLookupIndex();
+
+	/**
+	 * Find a loaded blueprint by name ("BP_Enemy"), object path ("/Game/AI/BP_Enemy.BP_Enemy") or package path ("/Game/AI/BP_Enemy").
+	 * Returns null when no such blueprint is in memory; see LoadAsync.
+	 */
+	UBlueprint* Find(const FString& NameOrPath);
+
+	/**
+	 * Start async loads for the named blueprint assets that are not in memory yet. Requests for an asset that
+	 * is already streaming join its load. OnLoaded runs on the game thread once all of them have finished
+	 * (successfully or not). Returns false, without calling OnLoaded, when there is nothing to wait for.
+	 */
+	bool LoadAsync(const TArray<FString>& Names, TFunction<void()>&& OnLoaded);
+
+	/** Blueprints currently open in an asset editor */
+	TArray<UBlueprint*> GetOpenBlueprints() const;
+
+private:
+	/** Callers waiting on a set of loads */
+	struct FLoadGroup
+	{
+		/** Outstanding loads, plus one held by LoadAsync until it has issued them all */
+		int32 Remaining = 1;
+		TFunction<void()> OnLoaded;
+		/** Keeps what has streamed in so far from being collected before OnLoaded runs */
+		TArray<TSharedPtr<FStreamableHandle>> Handles;
+	};
+
+	struct FPendingLoad
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		TArray<TSharedRef<FLoadGroup>> Groups;
+		double StartTime = 0.0;
+	};
+
+	static void Release(const TSharedRef<FLoadGroup>& Group);
+	void OnLoadComplete(FSoftObjectPath AssetPath);
+
+	void Remember(UBlueprint* Blueprint);
+	void Forget(const UBlueprint* Blueprint);
+	FSoftObjectPath FindAssetPath(const FString& NameOrPath) const;
+
+	void IndexAsset(const FAssetData& AssetData);
+	void UnindexAsset(FName AssetName, const FSoftObjectPath& AssetPath);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetOpened(UObject* Asset, IAssetEditorInstance* EditorInstance);
+	void OnAssetClosed(UObject* Asset, IAssetEditorInstance* EditorInstance);
+
+	/** Loaded blueprints by name, object path and package path (FString keys compare case-insensitively, like asset paths) */
+	TMap<FString, TWeakObjectPtr<UBlueprint>> Loaded;
+
+	/** Every blueprint asset the Asset Registry knows about, by asset name */
+	TMap<FName, TArray<FSoftObjectPath>> AssetsByName;
+
+	TSet<TWeakObjectPtr<UBlueprint>> OpenBlueprints;
+
+	FStreamableManager Streamable;
+	TMap<FSoftObjectPath, FPendingLoad> PendingLoads;
+
+	/** Assets whose load produced no blueprint; not retried until the registry reports them again */
+	TSet<FSoftObjectPath> FailedLoads;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetOpenedHandle;
+	FDelegateHandle AssetClosedHandle;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UPackage;
+struct FEdGraphEditAction;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBlueprintRevisionChanged, UBlueprint*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBlueprintNodeChanged, UBlueprint*, const UEdGraphNode*);
+
+/**
+ * Keeps a revision counter per blueprint, bumped by UBlueprint::OnChanged, OnCompiled,
+ * graph change notifications and package-dirty events. Lets the HTTP layer answer
+ * "has this blueprint changed?" without serializing it.
+ */
+class BLUEPRINTAIBRIDGE_API FBlueprintRevisionTracker
+{
+public:
+	FBlueprintRevisionTracker();
+	~FBlueprintRevisionTracker();
+
+	/** Current revision of a blueprint; starts watching it on first use */
+	uint64 GetRevision(UBlueprint* Blueprint);
+
+	/** Strong ETag for one representation (e.g. "json", "cb") of the blueprint's current revision */
+	FString MakeETag(UBlueprint* Blueprint, const TCHAR* Representation);
+
+	/** Fired on the game thread whenever a watched blueprint moves to a new revision */
+	FOnBlueprintRevisionChanged& OnRevisionChanged() { return RevisionChangedEvent; }
+
+	/** Fired when a node of a watched blueprint is Modify()'d, added or removed */
+	FOnBlueprintNodeChanged& OnNodeChanged() { return NodeChangedEvent; }
+
+	/** Fired for blueprint-wide edits (structure, variables, class settings) that no single node accounts for */
+	FOnBlueprintRevisionChanged& OnStructureChanged() { return StructureChangedEvent; }
+
+private:
+	struct FWatch
+	{
+		uint64 Revision = 0;
+		FDelegateHandle ChangedHandle;
+		FDelegateHandle CompiledHandle;
+		TMap<TWeakObjectPtr<UEdGraph>, FDelegateHandle> GraphHandles;
+	};
+
+	FWatch& Watch(UBlueprint* Blueprint);
+	void WatchGraphs(UBlueprint* Blueprint, FWatch& Entry);
+	void Unwatch(UBlueprint* Blueprint, FWatch& Entry);
+	void Bump(UBlueprint* Blueprint);
+
+	void OnBlueprintChanged(UBlueprint* Blueprint);
+	void OnBlueprintCompiled(UBlueprint* Blueprint);
+	void OnGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UBlueprint> Blueprint);
+	void OnPackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	void OnObjectModified(UObject* Object);
+
+	TMap<TWeakObjectPtr<UBlueprint>, FWatch> Watches;
+	FDelegateHandle PackageDirtyHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FOnBlueprintRevisionChanged RevisionChangedEvent;
+	FOnBlueprintNodeChanged NodeChangedEvent;
+	FOnBlueprintRevisionChanged StructureChangedEvent;
+
+	/** Revisions come from one counter so a value is never reused, even across blueprints */
+	uint64 NextRevision = 1;
+
+	/** Distinguishes ETags from a previous editor session that happened to reach the same counter */
+	uint32 SessionTag;
+};
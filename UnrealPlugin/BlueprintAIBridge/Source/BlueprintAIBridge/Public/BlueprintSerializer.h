@@ -1,45 +1,228 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Dom/JsonObject.h"
-#include "Dom/JsonValue.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/WeakObjectPtr.h"
+#include "BlueprintCbWriter.h"
+#include "BlueprintData.h"
+#include "BlueprintIdRegistry.h"
 
 class UBlueprint;
 class UEdGraph;
 class UK2Node;
 class UEdGraphPin;
+struct FEdGraphPinType;
+
+/** Encodings GET /api/blueprint can answer with; JSON unless the client asks otherwise */
+enum class EBlueprintWireFormat : uint8
+{
+	Json,
+	/** UE Compact Binary (application/x-ue-cb): same field names, typed values, Uuid IDs */
+	CompactBinary
+};
+
+/** Parts of each node (and of the document) a partial export writes; the node ID is always written */
+enum class EBlueprintExportFields : uint8
+{
+	None = 0,
+	Title = 1 << 0,
+	Category = 1 << 1,
+	Style = 1 << 2,
+	Position = 1 << 3,
+	Pins = 1 << 4,
+	Connections = 1 << 5,
+	Variables = 1 << 6,
+	All = Title | Category | Style | Position | Pins | Connections | Variables
+};
+ENUM_CLASS_FLAGS(EBlueprintExportFields);
+
+/** Selects part of a blueprint to export. Filters intersect; a default query exports everything. */
+struct FBlueprintExportQuery
+{
+	/** Only this graph (UbergraphPages or FunctionGraphs entry, by name) */
+	FString Graph;
+	/** Only nodes positioned inside this box, in graph coordinates */
+	TOptional<FBox2D> Region;
+	/** Only these nodes, plus everything up to Hops links away from them */
+	TSet<FGuid> NodeGuids;
+	int32 Hops = 0;
+	EBlueprintExportFields Fields = EBlueprintExportFields::All;
+
+	bool IsFull() const
+	{
+		return Graph.IsEmpty() && !Region.IsSet() && NodeGuids.Num() == 0 && Fields == EBlueprintExportFields::All;
+	}
+
+	/** Canonical form of the query, for telling different partial exports of the same revision apart */
+	FString ToKey() const;
+};
+
+/**
+ * Everything one export writes, copied off the UObjects on the game thread so it can be encoded on any thread.
+ * Unchanged nodes carry their cached encoding instead of their fields.
+ */
+struct FBlueprintExportSnapshot
+{
+	struct FNode
+	{
+		FString Id;
+		/** Generation of the node's fragment when captured; the encoding is only cached back if it still matches */
+		uint32 Generation = 0;
+		/** Cached node encoding as condensed UTF-8 JSON, spliced into the output as-is */
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Json;
+		TOptional<FCbObject> CompactBinary;
+		/** Captured fields of a node with no cached encoding in this format */
+		TOptional<FBlueprintNodeData> Data;
+	};
+
+	FString Name;
+	EBlueprintWireFormat Format = EBlueprintWireFormat::Json;
+	EBlueprintExportFields Fields = EBlueprintExportFields::All;
+	/** Written as "partial": true, so a client never mistakes a subset for the whole graph */
+	bool bPartial = false;
+	TArray<FNode> Nodes;
+	TArray<FBlueprintConnectionData> Connections;
+	TArray<FBlueprintVariableData> Variables;
+
+	/** Expected output size, to presize the buffer */
+	int32 SizeHint = 0;
+	int32 CapturedNodeCount = 0;
+	double CaptureSeconds = 0.0;
+	double EncodeSeconds = 0.0;
+};
 
 /**
  * Serializes UE Blueprint graphs into JSON compatible with the BlueprintAI domain model.
  * Maintains a mapping registry so IDs can be resolved back during deserialization.
+ *
+ * An export runs in two phases: Capture walks the graphs on the game thread into an FBlueprintExportSnapshot,
+ * and Encode writes the snapshot out, on whichever thread is convenient.
  */
-class BLUEPRINTAIBRIDGE_API FBlueprintSerializer
+class BLUEPRINTAIBRIDGE_API FBlueprintSerializer : public TSharedFromThis<FBlueprintSerializer>
 {
 public:
+	using FUtf8JsonWriter = TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>;
+	using FOnExportEncoded = TFunction<void(TArray<uint8>&& Body, const FBlueprintExportSnapshot& Snapshot)>;
+
+	FBlueprintSerializer();
+	~FBlueprintSerializer();
+
 	/**
-	 * Serialize an entire blueprint into a JSON object.
+	 * Serialize an entire blueprint straight to condensed UTF-8 JSON (or Compact Binary), without building a DOM.
+	 * The returned buffer can be moved into an HTTP response as-is.
 	 * Populates internal mapping registry for round-trip support.
 	 */
-	TSharedPtr<FJsonObject> SerializeBlueprint(UBlueprint* Blueprint);
+	TArray<uint8> SerializeBlueprint(UBlueprint* Blueprint, EBlueprintWireFormat Format = EBlueprintWireFormat::Json,
+		const FBlueprintExportQuery& Query = FBlueprintExportQuery());
+
+	/**
+	 * Capture now and encode on the task graph. OnEncoded runs on the game thread once the body is ready,
+	 * unless this serializer has been destroyed in the meantime.
+	 */
+	void SerializeBlueprintAsync(UBlueprint* Blueprint, EBlueprintWireFormat Format, FOnExportEncoded&& OnEncoded,
+		const FBlueprintExportQuery& Query = FBlueprintExportQuery());
+
+	/**
+	 * Game-thread phase: register IDs and copy out whatever the fragment cache can't supply.
+	 * A partial query only visits the nodes it selects, so its cost follows the size of the answer.
+	 */
+	TSharedRef<FBlueprintExportSnapshot, ESPMode::ThreadSafe> Capture(UBlueprint* Blueprint, EBlueprintWireFormat Format,
+		const FBlueprintExportQuery& Query = FBlueprintExportQuery());
+
+	/** The graphs an export covers: all of them, or the one named (false if there is no such graph) */
+	static bool GatherGraphs(UBlueprint* Blueprint, const FString& GraphName, TArray<UEdGraph*>& OutGraphs);
+
+	/** Encode phase: touches nothing but the snapshot, so it is safe off the game thread */
+	static TArray<uint8> Encode(FBlueprintExportSnapshot& Snapshot);
+
+	/** Game-thread follow-up to Encode: keep the nodes it encoded for the next export, and log the timings */
+	void AdoptEncodedNodes(const FBlueprintExportSnapshot& Snapshot, int32 OutputSize);
 
 	/** Get the node mapping (generated GUID -> UEdGraphNode*) */
-	const TMap<FString, class UEdGraphNode*>& GetNodeMap() const { return NodeMap; }
+	const TMap<FString, class UEdGraphNode*>& GetNodeMap() const { return Registry.GetNodeMap(); }
 
 	/** Get the pin mapping (generated GUID -> UEdGraphPin*) */
-	const TMap<FString, UEdGraphPin*>& GetPinMap() const { return PinMap; }
+	const TMap<FString, UEdGraphPin*>& GetPinMap() const { return Registry.GetPinMap(); }
+
+	/** Get the bidirectional ID registry populated by the last export */
+	const FBlueprintIdRegistry& GetRegistry() const { return Registry; }
 
 	/** Clear all mappings */
 	void ClearMappings();
 
+	/** Map a K2 node to the BlueprintAI NodeStyle name ("Event", "Function", "Pure", ...) */
+	static FString MapNodeStyle(UK2Node* Node);
+
+	/** Map a variable pin type to the BlueprintAI PinType name ("Bool", "Float", "Vector", ...) */
+	static FString MapPinTypeFromPinType(const FEdGraphPinType& PinType);
+
 private:
-	TSharedPtr<FJsonObject> SerializeNode(UK2Node* Node);
-	TSharedPtr<FJsonObject> SerializePin(UEdGraphPin* Pin);
-	TArray<TSharedPtr<FJsonValue>> SerializeConnections(UEdGraph* Graph);
-	TArray<TSharedPtr<FJsonValue>> SerializeVariables(UBlueprint* Blueprint);
-	FString MapNodeStyle(UK2Node* Node) const;
+	/** A node's encoded form, reused across exports until the node changes */
+	struct FNodeFragment
+	{
+		uint32 Fingerprint = 0;
+		uint32 Generation = 0;
+		uint32 LastExport = 0;
+		/** Registry ID per entry of Node->Pins (empty for hidden pins) */
+		TArray<FString> PinIds;
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Json;
+		TOptional<FCbObject> CompactBinary;
+	};
+
+	/** FUtf8JsonWriter that can also append an element already encoded as UTF-8 JSON, byte for byte */
+	class FSplicingJsonWriter : public FUtf8JsonWriter
+	{
+	public:
+		explicit FSplicingJsonWriter(FArchive* InStream) : FUtf8JsonWriter(InStream, 0) {}
+		void WriteRawUtf8Value(TConstArrayView<uint8> Json);
+	};
+
+	/** Capture helpers; game thread only */
+	void CaptureNode(UK2Node* Node, FBlueprintExportSnapshot& Snapshot);
+	void CaptureNodeData(UK2Node* Node, const FString& NodeId, const TArray<FString>& PinIds, EBlueprintExportFields Fields,
+		FBlueprintNodeData& OutNode) const;
+	static void SelectNodes(const TArray<UEdGraph*>& Graphs, const FBlueprintExportQuery& Query, TArray<UK2Node*>& OutNodes);
+	void CaptureConnections(const TArray<UK2Node*>& Nodes, TArray<FBlueprintConnectionData>& OutConnections) const;
+	static void CaptureVariables(UBlueprint* Blueprint, TArray<FBlueprintVariableData>& OutVariables);
+
+	/** Writes the export document; WriterType is FSplicingJsonWriter or FBlueprintCbWriter */
+	template <typename WriterType>
+	static void WriteBlueprint(WriterType& Writer, FBlueprintExportSnapshot& Snapshot);
+	static void WriteNode(FSplicingJsonWriter& Writer, FBlueprintExportSnapshot::FNode& Node, EBlueprintExportFields Fields);
+	static void WriteNode(FBlueprintCbWriter& Writer, FBlueprintExportSnapshot::FNode& Node, EBlueprintExportFields Fields);
+	template <typename WriterType>
+	static void WriteNodeBody(WriterType& Writer, const FBlueprintNodeData& Node, EBlueprintExportFields Fields);
+	template <typename WriterType>
+	static void WritePin(WriterType& Writer, const FBlueprintPinData& Pin, const TCHAR* Direction);
+	template <typename WriterType>
+	static void WriteConnection(WriterType& Writer, const FBlueprintConnectionData& Connection);
+	template <typename WriterType>
+	static void WriteVariable(WriterType& Writer, const FBlueprintVariableData& Variable);
+
+	static void LogExport(const FBlueprintExportSnapshot& Snapshot, int32 OutputSize);
+
+	template <typename CharType, typename PrintPolicy>
+	static void WriteId(TJsonWriter<CharType, PrintPolicy>& Writer, const TCHAR* Key, const FString& Id);
+	static void WriteId(FBlueprintCbWriter& Writer, const TCHAR* Key, const FString& Id);
 	FString MapPinType(UEdGraphPin* Pin) const;
-	FString MapPinTypeFromPinType(const FEdGraphPinType& PinType) const;
 
-	TMap<FString, UEdGraphNode*> NodeMap;
-	TMap<FString, UEdGraphPin*> PinMap;
+	static uint32 ComputeFingerprint(const UK2Node* Node);
+	void OnObjectModified(UObject* Object);
+
+	FBlueprintIdRegistry Registry;
+
+	/** Encoded nodes keyed by node ID */
+	TMap<FString, FNodeFragment> Fragments;
+
+	/** Nodes Modify()'d since the last full export */
+	TSet<const UEdGraphNode*> DirtyNodes;
+
+	TWeakObjectPtr<UBlueprint> ExportedBlueprint;
+	FDelegateHandle ObjectModifiedHandle;
+	uint32 ExportCounter = 0;
+	uint32 NextFragmentGeneration = 1;
+
+	/** Size of the previous export, used to presize the next output buffer */
+	int32 LastExportSize = 0;
 };
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FJsonObject;
+class UBlueprint;
+
+enum class EBridgeJobState : uint8
+{
+	Queued,
+	Running,
+	Succeeded,
+	Failed,
+	Cancelled
+};
+
+/** A long-running bridge operation accepted with 202 and polled through /api/jobs/{id} */
+struct FBridgeJob
+{
+	FString Id;
+	/** "apply" or "create" */
+	FString Kind;
+	/** Blueprint name or path the job works on; jobs on the same target start in submission order */
+	FString Target;
+	EBridgeJobState State = EBridgeJobState::Queued;
+	/** What a running job is doing ("creating", "applying", "saving", ...) */
+	FString Phase;
+	/** Set once the job knows its blueprint, so a poll can add live apply progress */
+	TWeakObjectPtr<UBlueprint> Blueprint;
+
+	double QueuedTime = 0.0;
+	double StartTime = 0.0;
+	double FinishTime = 0.0;
+
+	/** The reply the blocking route would have sent */
+	TSharedPtr<FJsonObject> Result;
+
+	/** Begins the work; returns false to be retried next tick (e.g. while its blueprint is busy) */
+	TFunction<bool(FBridgeJob&)> Start;
+	/** Stops a running job; returns false once it is too far along to stop (compiling or saving) */
+	TFunction<bool()> Cancel;
+
+	bool IsFinished() const { return State > EBridgeJobState::Running; }
+};
+
+/**
+ * Runs bridge operations that would outlast an HTTP timeout. Submitting returns at once; queued jobs
+ * start from the core ticker and finish whenever their work does, on whatever schedule it keeps.
+ * Finished jobs are kept for a while so late pollers still see their results.
+ */
+class BLUEPRINTAIBRIDGE_API FBridgeJobQueue
+{
+public:
+	/** How long a finished job stays queryable */
+	static constexpr double RetainSeconds = 600.0;
+
+	/** Most finished jobs kept, oldest dropped first */
+	static constexpr int32 MaxRetainedJobs = 256;
+
+	FBridgeJobQueue();
+	~FBridgeJobQueue();
+
+	TSharedRef<FBridgeJob> Submit(const FString& Kind, const FString& Target, TFunction<bool(FBridgeJob&)>&& Start);
+	TSharedPtr<FBridgeJob> Find(const FString& Id) const;
+
+	/** Record a job's outcome; ignored if it already finished (e.g. it was cancelled) */
+	void Finish(const FString& Id, bool bSuccess, const TSharedPtr<FJsonObject>& Result);
+
+	/** Cancel a queued job, or a running one whose Cancel hook agrees */
+	bool Cancel(FBridgeJob& Job);
+
+	static const TCHAR* LexState(EBridgeJobState State);
+
+private:
+	bool Tick(float DeltaTime);
+	void Prune(double Now);
+
+	TMap<FString, TSharedRef<FBridgeJob>> Jobs;
+	/** Jobs waiting to start, oldest first */
+	TArray<TSharedRef<FBridgeJob>> Queued;
+	FTSTicker::FDelegateHandle TickHandle;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FHttpServerHandler;
+class INetworkingWebSocket;
+class IWebSocketServer;
+class UBlueprint;
+
+/**
+ * Carries the bridge operations over one persistent WebSocket so a client can pipeline calls
+ * without paying HTTP connection setup and routing for each one.
+ *
+ * Every message is a binary frame holding a condensed JSON envelope, a '\n', then an optional raw
+ * payload (a BlueprintDelta, export or create request; JSON or Compact Binary):
+ *
+ *   request:  {"id":"7","op":"get","params":{"name":"BP_X"},"headers":{"Accept":"application/x-ue-cb"}}
+ *   response: {"id":"7","status":200,"contentType":"application/x-ue-cb","etag":"...","serverMs":0.41}
+ *   push:     {"event":"delta","blueprint":"BP_X","eventId":42}
+ *
+ * Ops are status, list, get, apply and create, which run through the same handlers as the HTTP routes,
+ * plus subscribe/unsubscribe ({"params":{"name":...}}) for change feed events. Responses carry the
+ * request's id and may arrive out of order.
+ */
+class BLUEPRINTAIBRIDGE_API FBridgeWebSocketServer : public TSharedFromThis<FBridgeWebSocketServer>
+{
+public:
+	explicit FBridgeWebSocketServer(FHttpServerHandler& InHandler);
+	~FBridgeWebSocketServer();
+
+	bool Start(uint32 Port);
+	void Stop();
+
+private:
+	struct FConnection
+	{
+		TUniquePtr<INetworkingWebSocket> Socket;
+		TSet<TWeakObjectPtr<UBlueprint>> Subscriptions;
+		bool bClosed = false;
+	};
+
+	struct FEnvelope;
+
+	void OnClientConnected(INetworkingWebSocket* Socket);
+	void OnMessage(void* Data, int32 Size, uint32 ConnectionId);
+	void OnClosed(uint32 ConnectionId);
+	bool Tick(float DeltaTime);
+
+	/** Run one request through the HTTP handlers and send the result back under its id */
+	void Dispatch(uint32 ConnectionId, FEnvelope&& Request, TArray<uint8>&& Payload);
+	void SetSubscribed(uint32 ConnectionId, const FString& RequestId, const FString& BlueprintName, bool bSubscribe);
+	void OnChangeEvent(UBlueprint* Blueprint, uint64 EventId, const TCHAR* Name, const FString& Data);
+	void ReleaseSubscriptions(FConnection& Connection);
+
+	void SendFrame(uint32 ConnectionId, const FString& Envelope, TConstArrayView<uint8> Payload);
+	void SendError(uint32 ConnectionId, const FString& RequestId, int32 Status, const FString& Message);
+
+	FHttpServerHandler& Handler;
+	TUniquePtr<IWebSocketServer> Server;
+	TMap<uint32, FConnection> Connections;
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle ChangeEventHandle;
+	uint32 NextConnectionId = 1;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpServerRequest.h"
+
+/**
+ * HTTP content-coding helpers for the bridge: Accept-Encoding negotiation, response compression
+ * and inflating compressed request bodies. Uses the engine's zlib-backed FCompression formats.
+ */
+class BLUEPRINTAIBRIDGE_API FHttpCompression
+{
+public:
+	/** Responses smaller than this go out uncompressed; the saving doesn't pay for the round trip to a worker */
+	static constexpr int32 MinCompressedBodySize = 8 * 1024;
+
+	/** Largest request body we will inflate, so a tiny gzip bomb can't exhaust editor memory */
+	static constexpr int32 MaxInflatedBodySize = 256 * 1024 * 1024;
+
+	/** Pick the response coding from Accept-Encoding: NAME_Gzip, NAME_Zlib (deflate) or NAME_None */
+	static FName NegotiateEncoding(const FHttpServerRequest& Request);
+
+	/** Content-Encoding token for a format returned by NegotiateEncoding */
+	static const TCHAR* GetEncodingName(FName Format);
+
+	/** Compress a response body. Thread-safe; meant to run off the game thread. */
+	static bool Compress(FName Format, TConstArrayView<uint8> Body, TArray<uint8>& OutCompressed);
+
+	/**
+	 * Resolve the request body honoring Content-Encoding. OutBody views either the raw request body
+	 * or Storage when it had to be inflated. Returns false for unsupported codings or corrupt data.
+	 */
+	static bool DecodeRequestBody(const FHttpServerRequest& Request, TArray<uint8>& Storage, TConstArrayView<uint8>& OutBody);
+};
@@ -5,32 +5,128 @@
 #include "HttpServerRequest.h"
 #include "BlueprintSerializer.h"
 #include "BlueprintDeserializer.h"
+#include "BlueprintRevisionTracker.h"
+#include "BlueprintExportCache.h"
+#include "BlueprintChangeFeed.h"
+#include "BlueprintLookupIndex.h"
+#include "BridgeJobQueue.h"
+#include "BlueprintCompileQueue.h"
 
 /**
  * Handles all HTTP requests for the BlueprintAI bridge plugin.
  * Routes:
  *   GET  /api/status                - Health check + engine version
  *   GET  /api/blueprints            - List open blueprints in editor
- *   GET  /api/blueprint?name=X      - Export blueprint graph as JSON
- *   POST /api/blueprint/apply?name=X - Apply delta/full-sync to blueprint
+ *   GET  /api/blueprints?scope=project - Page through every blueprint asset from Asset Registry tags, nothing loaded
+ *                                     (path= prefix, /Game content when absent; parentClass=, modifiedSince=, limit=,
+ *                                     cursor= from the previous page's nextCursor)
+ *   GET  /api/blueprint?name=X      - Export blueprint graph as JSON (or Compact Binary with Accept: application/x-ue-cb);
+ *                                     honors If-None-Match against the blueprint's revision ETag. Optional graph=, region=x0,y0,x1,y1,
+ *                                     nodes=id,id&hops=N and fields=title,position,... export part of it, marked "partial": true
+ *   POST /api/blueprint/apply?name=X - Apply delta/full-sync to blueprint (JSON or Content-Type: application/x-ue-cb);
+ *                                     large full syncs (or ?sliced=true) are applied a few ms per frame, replying when done
+ *   GET  /api/blueprint/apply/progress?name=X - Phase and node/link counts of a sliced full sync in progress
+ *   POST /api/blueprint/compile?name=X - Compile now, with anything else awaiting compilation, and return errors/warnings per node;
+ *                                     applies otherwise only queue a compile, which runs once the blueprint has been quiet a moment
  *   POST /api/blueprint/create       - Create a new blueprint asset
+ *   GET  /api/jobs/{id}              - State, phase, timings and result of an ?async=true apply or create (which answer 202)
+ *   DELETE /api/jobs/{id}            - Cancel a job that has not reached compilation
+ *   POST /api/blueprints/batch-get    - Export several blueprints in one response ({ "names": [...] }, per-item status)
+ *   GET  /api/blueprint/events?name=X - Editor-side edits as text/event-stream BlueprintDelta records (Last-Event-ID or ?since= to resume)
+ *
+ * Wherever a blueprint name is taken, an asset path works too. Blueprints that are not in memory are streamed in
+ * asynchronously; the request is parked until the load finishes, and concurrent requests share one load.
  */
-class BLUEPRINTAIBRIDGE_API FHttpServerHandler
+class BLUEPRINTAIBRIDGE_API FHttpServerHandler : public TSharedFromThis<FHttpServerHandler>
 {
 public:
+	FHttpServerHandler();
+
 	bool HandleStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleListBlueprints(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleGetBlueprint(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleApplyBlueprint(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleApplyProgress(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleGetJob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleCancelJob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleCompileBlueprint(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleCreateBlueprint(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleBlueprintEvents(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleBatchGetBlueprints(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/** Resolve a loaded blueprint; see LoadBlueprintsAsync for ones that are not in memory */
+	UBlueprint* FindBlueprintByName(const FString& Name);
+	/** Stream in any of Names that are not loaded; false (and no callback) when there is nothing to wait for */
+	bool LoadBlueprintsAsync(const TArray<FString>& Names, TFunction<void()>&& OnLoaded);
+	FBlueprintChangeFeed& GetChangeFeed() { return ChangeFeed; }
 
 private:
-	UBlueprint* FindBlueprintByName(const FString& Name) const;
+	bool HandleListProjectBlueprints(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	/** Read graph/region/nodes/hops/fields from the query string; false with OutError on a malformed parameter */
+	static bool ParseExportQuery(const FHttpServerRequest& Request, FBlueprintExportQuery& OutQuery, FString& OutError);
+
+	/** Deepest neighborhood a node query may ask for */
+	static constexpr int32 MaxExportHops = 32;
+
+	/** Blueprint creation, split so the job API can run the steps apart */
+	UBlueprint* CreateBlueprintAsset(const FBlueprintCreateRequest& CreateRequest, FString& OutError);
+	void SaveAndOpenBlueprint(UBlueprint* NewBlueprint);
+	static TSharedPtr<FJsonObject> MakeCreateResult(UBlueprint* NewBlueprint);
+	static TSharedPtr<FJsonObject> MakeApplyResult(bool bSuccess, const FString& Error);
+
+	/** ?async=true: answer 202 with a job ID and do the work from the job queue */
+	static bool IsAsyncRequest(const FHttpServerRequest& Request);
+	void SendJobAccepted(const FHttpResultCallback& OnComplete, const FBridgeJob& Job);
+	bool SubmitApplyJob(const FHttpResultCallback& OnComplete, UBlueprint* Blueprint, FBlueprintDeltaData&& Delta);
+	bool SubmitCreateJob(const FHttpResultCallback& OnComplete, FBlueprintCreateRequest&& CreateRequest);
+	bool StartSlicedJob(FBridgeJob& Job, UBlueprint* Blueprint, FBlueprintStateData&& State, TFunction<void(bool bSuccess)>&& OnApplied);
+
+	static bool ShouldSliceApply(const FHttpServerRequest& Request, const FBlueprintStateData& State);
+
+	/** Nodes plus connections from which a full sync is applied across frames by default */
+	static constexpr int32 SlicedApplyThreshold = 1000;
+
+	using FRouteHandler = bool (FHttpServerHandler::*)(const FHttpServerRequest&, const FHttpResultCallback&);
+
+	/** Park the request until Names have streamed in, then run Route again; false when nothing needs loading */
+	bool DeferUntilLoaded(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete,
+		const TArray<FString>& Names, FRouteHandler Route);
+
+	void OnBlueprintRevisionChanged(UBlueprint* Blueprint);
+	TSharedPtr<FBlueprintSerializer> FindOrCreateSerializer(const FString& BlueprintPath);
+	/** Send a response body, compressing it off the game thread when the client accepts gzip/deflate and it is large enough */
+	static void SendResponse(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, TArray<uint8>&& Body,
+		const FString& ContentType, const FString& ETag = FString());
+	/** Send a shared body (a cached export) without copying it more than the response itself requires */
+	static void SendResponse(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, const FBlueprintExportCache::FBody& Body,
+		const FString& ContentType, const FString& ETag = FString());
+	static void SendCompressed(const FHttpResultCallback& OnComplete, const FBlueprintExportCache::FBody& Body,
+		const FString& ContentType, const FString& ETag, FName Encoding);
+	static bool MatchesIfNoneMatch(const FHttpServerRequest& Request, const FString& ETag);
+	static bool HeaderHasMediaType(const FHttpServerRequest& Request, const TCHAR* Header, const TCHAR* MediaType);
 	TUniquePtr<FHttpServerResponse> MakeJsonResponse(const TSharedPtr<FJsonObject>& Json);
 	TUniquePtr<FHttpServerResponse> MakeErrorResponse(int32 Code, const FString& Message);
 
-	/** Per-blueprint serializer instances maintain ID mapping registries */
+	/** Name/path -> blueprint, including blueprints not open in any editor */
+	FBlueprintLookupIndex Lookup;
+
+	/** Per-blueprint serializer instances maintain ID mapping registries, keyed by object path */
 	TMap<FString, TSharedPtr<FBlueprintSerializer>> Serializers;
 
+	/** Debounced compiles of applied blueprints; must be declared before Deserializer, which feeds it */
+	FBlueprintCompileQueue Compiles;
+
 	FBlueprintDeserializer Deserializer;
+
+	/** Per-blueprint change counters backing the export ETags */
+	FBlueprintRevisionTracker Revisions;
+
+	/** Encoded exports reused until their blueprint's revision moves on */
+	FBlueprintExportCache ExportCache;
+
+	/** Live edit notifications; must be declared after Revisions, which it listens to */
+	FBlueprintChangeFeed ChangeFeed;
+
+	/** Long-running applies and creates accepted with ?async=true */
+	FBridgeJobQueue Jobs;
 };